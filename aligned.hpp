@@ -0,0 +1,53 @@
+#pragma once
+
+#include <cstddef>
+#include <new>
+#include <vector>
+
+/// Allocator returning storage aligned to @c Alignment bytes.
+/// @discussion The default of 64 bytes is one cache line, and suits the widest SIMD register.
+template <typename T, std::size_t Alignment = 64>
+class AlignedAllocator
+{
+public:
+    using value_type = T;
+
+    template <typename U>
+    struct rebind
+    {
+        using other = AlignedAllocator<U, Alignment>;
+    };
+
+    AlignedAllocator() = default;
+
+    template <typename U>
+    AlignedAllocator(const AlignedAllocator<U, Alignment> &)
+    {
+    }
+
+    T * allocate(std::size_t n)
+    {
+        return static_cast<T *>(::operator new(n * sizeof(T), std::align_val_t{Alignment}));
+    }
+
+    void deallocate(T * p, std::size_t)
+    {
+        ::operator delete(p, std::align_val_t{Alignment});
+    }
+
+    template <typename U>
+    bool operator==(const AlignedAllocator<U, Alignment> &) const
+    {
+        return true;
+    }
+
+    template <typename U>
+    bool operator!=(const AlignedAllocator<U, Alignment> &) const
+    {
+        return false;
+    }
+};
+
+/// Contiguous, cache-line aligned buffer.
+template <typename T>
+using AlignedVector = std::vector<T, AlignedAllocator<T>>;
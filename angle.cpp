@@ -1,145 +1,181 @@
 #include "angle.hpp"
 
-#include <cmath>
-
-#ifndef M_TWOPI
-#define M_TWOPI (2.0 * M_PI)
-#endif
-
-Angle::Angle() : rad_{}
-{
-}
-
-Angle Angle::radians(double rad)
-{
-    return Angle(rad);
-}
+#include "instrument.hpp"
 
-Angle Angle::degrees(double deg)
-{
-    return Angle(deg / 360. * M_TWOPI);
-}
+#include <cmath>
+#include <type_traits>
 
 namespace
 {
 
-/// @return Radians in the range 0..2π.
-double scale(double rad)
-{
-    while (rad < 0)        rad += M_TWOPI;
-    while (rad >= M_TWOPI) rad -= M_TWOPI;
-    return rad;
-}
-
-} // namespace
-
-Angle::Angle(double rad)
-{
-    rad_ = scale(rad);
-}
-
-double Angle::rad() const
-{
-    return rad_;
-}
-
-double Angle::deg() const
-{
-    return rad_ * 360. / M_TWOPI;
-}
-
-Angle::operator double() const
-{
-    return rad_;
-}
-
-Angle & Angle::operator+=(const Angle & other)
-{
-    rad_ = scale(rad_ + other.rad_);
-    return *this;
-}
+/// 2π split into three parts (Cody–Waite) carrying ~160 significant bits.
+constexpr double TWOPI_1 =  0x1.921fb54442d18p+2;
+constexpr double TWOPI_2 =  0x1.1a62633145c07p-52;
+constexpr double TWOPI_3 = -0x1.f1976b7ed8fbcp-108;
 
-Angle & Angle::operator-=(const Angle & other)
-{
-    rad_ = scale(rad_ - other.rad_);
-    return *this;
-}
+/// Magnitude below which the number of whole turns is exactly representable.
+constexpr double TWOPI_LIMIT = 0x1p+52;
 
-Angle & Angle::operator/=(double denominator)
-{
-    rad_ = scale(rad_ / denominator);
-    return *this;
-}
+} // namespace
 
-Angle & Angle::operator%= (const Angle & other)
-{
-    rad_ = scale(fmod(rad_, other.rad_));
+/// @discussion Runs in constant time for any magnitude. Reduces in at least double precision. Results one ulp
+/// below 2π snap to 0, so small multiples of @c TWOPI reduce to 0, as @c TWOPI itself does.
+template <typename T>
+T BasicAngle<T>::reduce(T rad)
+{
+    TRIG_COUNT(REDUCE);
+
+    using Wide = std::common_type_t<T, double>;
+    Wide r;
+    if (std::fabs(rad) < TWOPI_LIMIT) {
+        // Subtract k whole turns; each fused product k·2πᵢ is exact.
+        auto k = std::floor(rad / Wide(TWOPI_1));
+        r = std::fma(-k, Wide(TWOPI_1), Wide(rad));
+        r = std::fma(-k, Wide(TWOPI_2), r);
+        r = std::fma(-k, Wide(TWOPI_3), r);
+    } else {
+        // Beyond 2^52 radians, defer to the exact argument reduction in libm.
+        // Non-finite input yields NaN.
+        TRIG_COUNT(TRIG);
+        TRIG_COUNT(TRIG);
+        TRIG_COUNT(TRIG);
+        r = std::atan2(std::sin(Wide(rad)), std::cos(Wide(rad)));
+    }
+
+    // Correct for rounding at the edges of the range, in T. A result one ulp below 2π is a whole turn that
+    // rounded down (as for 2·TWOPI), so snaps to 0.
+    auto t = static_cast<T>(r);
+    if (t < 0)         t += TWOPI<T>;
+    if (t >= TWOPI<T>) t -= TWOPI<T>;
+    if (t == std::nextafter(TWOPI<T>, T(0))) t = 0;
+    return t;
+}
+
+template <typename T>
+BasicAngle<T> & BasicAngle<T>::operator%= (const BasicAngle & other)
+{
+    rad_ = scale(std::fmod(rad_, other.rad_));
     return *this;
 }
 
-Angle Angle::operator+(const Angle & other) const
+template <typename T>
+BasicAngle<T> BasicAngle<T>::operator%(const BasicAngle & other) const
 {
-    return Angle(rad_ + other.rad_);
+    return BasicAngle(std::fmod(rad_, other.rad_));
 }
 
-Angle Angle::operator-(const Angle & other) const
-{
-    return Angle(rad_ - other.rad_);
-}
-
-Angle Angle::operator/(double denominator) const
-{
-    return Angle(rad_ / denominator);
-}
-
-Angle Angle::operator%(const Angle & other) const
-{
-    return Angle(fmod(rad_, other.rad_));
-}
+template class BasicAngle<float>;
+template class BasicAngle<double>;
+template class BasicAngle<long double>;
 
 #ifdef UNITTEST_ANGLE
 
 #include "fcmp.hpp"
 
 #include <cassert>
+#include <initializer_list>
 
-int main()
+namespace
 {
-    assert(fcmp(Angle(), Angle::radians(0)));
-    assert(fcmp(Angle(), Angle::degrees(0)));
-
-    Angle a = Angle::radians(M_PI_2);
-    assert(fcmp(a, M_PI_2));
-    assert(fcmp(a.rad(), M_PI_2));
-    assert(fcmp(a.deg(), 90));
-
-    assert(fcmp(Angle::degrees(45) + Angle::radians(M_PI_4), Angle::degrees(90)));
 
-    assert(fcmp(Angle::radians(M_PI) - Angle::degrees(45), Angle::degrees(135)));
-
-    assert(fcmp(Angle::degrees(135) / 3., Angle::degrees(45)));
+/// Check angles in precision @c T, to 3 decimal places.
+template <typename T>
+void test()
+{
+    using Angle = BasicAngle<T>;
 
-    assert(fcmp(Angle::degrees(135) / 3., Angle::degrees(45)));
+    static_assert(Angle().rad() == Angle::radians(0).rad());
+    static_assert(Angle().rad() == Angle::degrees(0).rad());
+    static_assert(Angle::radians(PI_2<T>).rad() == PI_2<T>);
+    static_assert(Angle::degrees(90) == Angle::radians(PI_2<T>));
 
+    assert(fcmp(Angle::radians(PI_2<T>).deg(), 90));
+    assert(fcmp(Angle::degrees(45) + Angle::radians(PI<T> / 4), Angle::degrees(90)));
+    assert(fcmp(Angle::radians(PI<T>) - Angle::degrees(45), Angle::degrees(135)));
+    assert(fcmp(Angle::degrees(135) / T(3), Angle::degrees(45)));
     assert(fcmp(Angle::degrees(365) % Angle::degrees(45), Angle::degrees(5)));
 
-    a = Angle::degrees(90);
-    assert(fcmp(a.rad(), M_PI_2));
-
-    a += Angle::radians(M_PI_2);
+    auto a = Angle::degrees(90);
+    a += Angle::radians(PI_2<T>);
     assert(fcmp(a, M_PI));
-    assert(fcmp(a.rad(), M_PI));
     assert(fcmp(a.deg(), 180));
 
-    a -= Angle::radians(M_PI_4);
+    a -= Angle::radians(PI<T> / 4);
     assert(fcmp(a.deg(), 135));
 
     a /= 3;
     assert(fcmp(a.deg(), 45));
 
     a += Angle::degrees(90);
-    a %= Angle::radians(M_PI_2);
+    a %= Angle::radians(PI_2<T>);
     assert(fcmp(a.deg(), 45));
+
+    // Whole turns.
+    assert(Angle::degrees(360).rad() == 0);
+    assert(Angle::degrees(-720).rad() == 0);
+    assert(fcmp(Angle::degrees(-90), Angle::degrees(270)));
+    assert(fcmp(Angle::radians(TWOPI<T>), 0));
+    assert(fcmp(Angle::radians(T(-1e-20)), 0));
+
+    // Large magnitudes reduce to the same sine and cosine, either side of 2^52.
+    for (T x : {T(12345.678), T(-1e9), T(1e30), T(-1e30)}) {
+        a = Angle::radians(x);
+        assert(a.rad() >= 0 && a.rad() < TWOPI<T>);
+        assert(fcmp(std::sin(a.rad()), std::sin(x), 5));
+        assert(fcmp(std::cos(a.rad()), std::cos(x), 5));
+    }
+
+    assert(std::isnan(Angle::radians(T(INFINITY)).rad()));
+    assert(std::isnan(Angle::radians(T(NAN)).rad()));
+}
+
+} // namespace
+
+int main()
+{
+    static_assert(PI<double> == M_PI && TWOPI<double> == M_TWOPI && PI_2<double> == M_PI_2);
+    static_assert(TWOPI<float> == static_cast<float>(M_TWOPI));
+    static_assert(PI<long double> > M_PI && PI<long double> - M_PI < 2e-16);
+
+    test<float>();
+    test<double>();
+    test<long double>();
+
+    // Double precision is exact where double arithmetic is.
+    constexpr Angle c = Angle::radians(M_PI_2);
+    static_assert(c == M_PI_2);
+    static_assert(c.deg() == 90);
+    static_assert(Angle::degrees(45) + Angle::radians(M_PI_4) == Angle::degrees(90));
+    static_assert(Angle::radians(M_PI) - Angle::degrees(45) == Angle::degrees(135));
+    static_assert(Angle::degrees(135) / 3. == Angle::degrees(45));
+    static_assert(Angle::degrees(90).rad() == M_PI_2);
+
+    // Small multiples of M_TWOPI reduce to 0, not to one ulp below 2π.
+    assert(Angle::degrees(720).rad() == 0);
+    for (auto k : {2., 3., 4.}) {
+        assert(Angle::radians(k * M_TWOPI).rad() == 0);
+    }
+    assert(fcmp(Angle::radians(-2 * M_TWOPI), 0, 15));
+
+    // Large magnitudes reduce in constant time against the exact value of 2π.
+    assert(fcmp(Angle::radians( 1e9),  0.5773954235013852, 12));
+    assert(fcmp(Angle::radians( 1e15), 2.1096981170701126, 12));
+    assert(fcmp(Angle::radians(-1e15), 4.173487190109474,  12));
+    assert(fcmp(Angle::radians(1e-12), 1e-12, 15));
+
+    auto a = Angle::radians(1e300);
+    assert(fcmp(sin(a), sin(1e300), 12));
+    assert(fcmp(cos(a), cos(1e300), 12));
+
+    a = Angle::radians(1e15);
+    a += Angle::radians(1e15);
+    assert(fcmp(a, 4.219396234140225,  12));
+    a -= Angle::radians(-1e15);
+    assert(fcmp(a, 0.04590904403075147, 12));
+
+    // Long double reduces to its own precision.
+    auto l = BasicAngle<long double>::radians(1e15L);
+    assert(std::fabs(l.rad() - 2.1096981170701126L) < 1e-15L);
 }
 
 #endif
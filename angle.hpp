@@ -1,50 +1,166 @@
 #pragma once
 
-/// Models an angle in radians or degrees.
-class Angle
+#include <cmath>
+
+#ifndef M_TWOPI
+#define M_TWOPI (2.0 * M_PI)
+#endif
+
+/// π in precision @c T.
+template <typename T>
+constexpr T PI = static_cast<T>(3.141592653589793238462643383279502884L);
+
+/// 2π in precision @c T (@c M_TWOPI, for @c double).
+template <typename T>
+constexpr T TWOPI = 2 * PI<T>;
+
+/// π/2 in precision @c T (@c M_PI_2, for @c double).
+template <typename T>
+constexpr T PI_2 = PI<T> / 2;
+
+/// Models an angle in radians or degrees, in floating point type @c T.
+/// @discussion Instantiated for @c float, @c double and @c long double.
+/// @see Angle
+template <typename T>
+class BasicAngle
 {
 public:
     /// Construct an empty angle (zero radians).
-    Angle();
+    constexpr BasicAngle();
 
     /// Construct angle in radians.
-    static Angle radians(double rad);
+    static constexpr BasicAngle radians(T rad);
 
     /// Construct angle in degrees.
-    static Angle degrees(double deg);
+    static constexpr BasicAngle degrees(T deg);
 
-    /// @return double Radians.
-    double rad() const;
+    /// @return T Radians.
+    constexpr T rad() const;
 
-    /// @return double Degrees.
-    double deg() const;
+    /// @return T Degrees.
+    constexpr T deg() const;
 
     /// Conversion operator.
     /// @see rad
     /// @return Angle in radians.
-    operator double() const;
+    constexpr operator T() const;
 
-    Angle & operator+=(const Angle & other);
+    constexpr BasicAngle & operator+=(const BasicAngle & other);
 
-    Angle & operator-=(const Angle & other);
+    constexpr BasicAngle & operator-=(const BasicAngle & other);
 
-    Angle & operator/=(double denominator);
+    constexpr BasicAngle & operator/=(T denominator);
 
-    Angle & operator%=(const Angle & other);
+    BasicAngle & operator%=(const BasicAngle & other);
 
-    Angle operator+(const Angle & other) const;
+    constexpr BasicAngle operator+(const BasicAngle & other) const;
 
-    Angle operator-(const Angle & other) const;
+    constexpr BasicAngle operator-(const BasicAngle & other) const;
 
-    Angle operator/(double denominator) const;
+    constexpr BasicAngle operator/(T denominator) const;
 
-    Angle operator%(const Angle & other) const;
+    BasicAngle operator%(const BasicAngle & other) const;
 
 private:
     /// Private constructor.
-    /// @see Angle::radians
-    /// @see Angle::degrees
-    Angle(double rad);
+    /// @see BasicAngle::radians
+    /// @see BasicAngle::degrees
+    constexpr BasicAngle(T rad);
 
-    double rad_;
+    /// @return Radians in the range 0..2π.
+    static constexpr T scale(T rad);
+
+    /// @return Radians outside of the range 0..2π, reduced into it.
+    static T reduce(T rad);
+
+    T rad_;
 };
+
+/// Angle in double precision.
+using Angle = BasicAngle<double>;
+
+template <typename T>
+constexpr BasicAngle<T>::BasicAngle() : rad_{}
+{
+}
+
+template <typename T>
+constexpr BasicAngle<T> BasicAngle<T>::radians(T rad)
+{
+    return BasicAngle(rad);
+}
+
+template <typename T>
+constexpr BasicAngle<T> BasicAngle<T>::degrees(T deg)
+{
+    // Whole turns are removed exactly in degrees, before 2π is approximated.
+    return BasicAngle((deg >= 0 && deg < 360 ? deg : std::fmod(deg, T(360))) / 360 * TWOPI<T>);
+}
+
+template <typename T>
+constexpr BasicAngle<T>::BasicAngle(T rad) : rad_{scale(rad)}
+{
+}
+
+template <typename T>
+constexpr T BasicAngle<T>::scale(T rad)
+{
+    return rad >= 0 && rad < TWOPI<T> ? rad : reduce(rad);
+}
+
+template <typename T>
+constexpr T BasicAngle<T>::rad() const
+{
+    return rad_;
+}
+
+template <typename T>
+constexpr T BasicAngle<T>::deg() const
+{
+    return rad_ * 360 / TWOPI<T>;
+}
+
+template <typename T>
+constexpr BasicAngle<T>::operator T() const
+{
+    return rad_;
+}
+
+template <typename T>
+constexpr BasicAngle<T> & BasicAngle<T>::operator+=(const BasicAngle & other)
+{
+    rad_ = scale(rad_ + other.rad_);
+    return *this;
+}
+
+template <typename T>
+constexpr BasicAngle<T> & BasicAngle<T>::operator-=(const BasicAngle & other)
+{
+    rad_ = scale(rad_ - other.rad_);
+    return *this;
+}
+
+template <typename T>
+constexpr BasicAngle<T> & BasicAngle<T>::operator/=(T denominator)
+{
+    rad_ = scale(rad_ / denominator);
+    return *this;
+}
+
+template <typename T>
+constexpr BasicAngle<T> BasicAngle<T>::operator+(const BasicAngle & other) const
+{
+    return BasicAngle(rad_ + other.rad_);
+}
+
+template <typename T>
+constexpr BasicAngle<T> BasicAngle<T>::operator-(const BasicAngle & other) const
+{
+    return BasicAngle(rad_ - other.rad_);
+}
+
+template <typename T>
+constexpr BasicAngle<T> BasicAngle<T>::operator/(T denominator) const
+{
+    return BasicAngle(rad_ / denominator);
+}
@@ -0,0 +1,242 @@
+#include "anglearray.hpp"
+
+#include "simd.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+
+/// Largest magnitude in degrees for which whole turns are removed exactly.
+constexpr double DEGREES_LIMIT = 0x1p+44;
+
+} // namespace
+
+AngleArray::AngleArray() : rad_{}
+{
+}
+
+AngleArray::AngleArray(std::size_t size) : rad_(size)
+{
+}
+
+AngleArray AngleArray::radians(const double * rad, std::size_t size)
+{
+    AngleArray a(size);
+
+    simd::transform(rad, a.rad_.data(), size, [](auto x) {
+        return simd::scale(x);
+    });
+
+    // Out-of-range and non-finite input takes the scalar path.
+    for (std::size_t i = 0; i < size; ++i) {
+        if (!(fabs(rad[i]) < simd::REDUCE_LIMIT)) {
+            a.rad_[i] = Angle::radians(rad[i]).rad();
+        }
+    }
+
+    return a;
+}
+
+AngleArray AngleArray::degrees(const double * deg, std::size_t size)
+{
+    AngleArray a(size);
+
+    simd::transform(deg, a.rad_.data(), size, [](auto x) {
+        // Whole turns are removed exactly in degrees, before 2π is approximated.
+        auto turns = simd::floor(x / 360.);
+        return simd::scale((x - turns * 360.) / 360. * M_TWOPI);
+    });
+
+    for (std::size_t i = 0; i < size; ++i) {
+        if (!(fabs(deg[i]) < DEGREES_LIMIT)) {
+            a.rad_[i] = Angle::degrees(deg[i]).rad();
+        }
+    }
+
+    return a;
+}
+
+AngleArray AngleArray::atan(const double * x, std::size_t size)
+{
+    AngleArray a(size);
+
+    simd::transform(x, a.rad_.data(), size, [](auto x) {
+        auto r = simd::atan(x);
+        return simd::select(r < 0., r + M_TWOPI, r);
+    });
+
+    return a;
+}
+
+std::size_t AngleArray::size() const
+{
+    return rad_.size();
+}
+
+const double * AngleArray::data() const
+{
+    return rad_.data();
+}
+
+Angle AngleArray::operator[](std::size_t index) const
+{
+    return Angle::radians(rad_[index]);
+}
+
+void AngleArray::push_back(const Angle & angle)
+{
+    rad_.push_back(angle.rad());
+}
+
+void AngleArray::rad(double * out) const
+{
+    std::copy(rad_.begin(), rad_.end(), out);
+}
+
+void AngleArray::deg(double * out) const
+{
+    simd::transform(rad_.data(), out, rad_.size(), [](auto x) {
+        return x * 360. / M_TWOPI;
+    });
+}
+
+void AngleArray::sin(double * out) const
+{
+    simd::transform(rad_.data(), out, rad_.size(), [](auto x) {
+        auto s = x, c = x;
+        simd::sincos(x, s, c);
+        return s;
+    });
+}
+
+void AngleArray::cos(double * out) const
+{
+    simd::transform(rad_.data(), out, rad_.size(), [](auto x) {
+        auto s = x, c = x;
+        simd::sincos(x, s, c);
+        return c;
+    });
+}
+
+void AngleArray::tan(double * out) const
+{
+    simd::transform(rad_.data(), out, rad_.size(), [](auto x) {
+        auto s = x, c = x;
+        simd::sincos(x, s, c);
+        return s / c;
+    });
+}
+
+#ifdef UNITTEST_ANGLEARRAY
+
+#include "fcmp.hpp"
+
+#include <cassert>
+#include <cstdint>
+#include <vector>
+
+namespace
+{
+
+/// @return Distance between @c x and the reference @c y, in units of the last place of @c y.
+double ulps(double x, double y)
+{
+    if (x == y || (std::isnan(x) && std::isnan(y))) {
+        return 0;
+    }
+    return fabs(x - y) / fabs(nextafter(y, INFINITY) - y);
+}
+
+} // namespace
+
+int main()
+{
+    // Inputs spanning every quadrant, both signs, whole turns, and magnitudes up to 1e15.
+    std::vector<double> x;
+    for (int i = -2000; i <= 2000; ++i) {
+        x.push_back(i * 0.00314159);
+        x.push_back(i * M_PI_4);
+        x.push_back(i * 45.);
+        x.push_back(i * 1e3 + 0.5);
+    }
+    for (double m = 1e-12; m < 1e16; m *= 10) {
+        x.push_back(m);
+        x.push_back(-m);
+    }
+    x.push_back(INFINITY);
+    x.push_back(NAN);
+    x.push_back(5e-324);
+
+    auto n = x.size();
+    std::vector<double> out(n), ref(n);
+
+    auto check = [&](double bound) {
+        double worst = 0;
+        for (std::size_t i = 0; i < n; ++i) {
+            worst = std::max(worst, ulps(out[i], ref[i]));
+        }
+        assert(worst <= bound);
+    };
+
+    auto radians = AngleArray::radians(x.data(), n);
+    assert(radians.size() == n);
+    assert(reinterpret_cast<std::uintptr_t>(radians.data()) % 64 == 0);
+    radians.rad(out.data());
+    for (std::size_t i = 0; i < n; ++i) {
+        ref[i] = Angle::radians(x[i]).rad();
+        assert(std::isnan(out[i]) || (out[i] >= 0 && out[i] < M_TWOPI));
+        assert(std::isnan(out[i]) || fabs(out[i] - ref[i]) <= 0x1p-49);
+    }
+
+    auto degrees = AngleArray::degrees(x.data(), n);
+    degrees.rad(out.data());
+    for (std::size_t i = 0; i < n; ++i) {
+        ref[i] = Angle::degrees(x[i]).rad();
+        assert(std::isnan(out[i]) || (out[i] >= 0 && out[i] < M_TWOPI));
+        assert(std::isnan(out[i]) || fabs(out[i] - ref[i]) <= 0x1p-49);
+    }
+
+    degrees.deg(out.data());
+    for (std::size_t i = 0; i < n; ++i) {
+        ref[i] = degrees[i].deg();
+    }
+    check(0);
+
+    radians.sin(out.data());
+    for (std::size_t i = 0; i < n; ++i) {
+        ref[i] = ::sin(radians[i]);
+    }
+    check(1);
+
+    radians.cos(out.data());
+    for (std::size_t i = 0; i < n; ++i) {
+        ref[i] = ::cos(radians[i]);
+    }
+    check(1);
+
+    radians.tan(out.data());
+    for (std::size_t i = 0; i < n; ++i) {
+        ref[i] = ::tan(radians[i]);
+    }
+    check(2);
+
+    auto atan = AngleArray::atan(x.data(), n);
+    atan.rad(out.data());
+    for (std::size_t i = 0; i < n; ++i) {
+        ref[i] = Angle::radians(::atan(x[i])).rad();
+    }
+    check(1);
+
+    // Accessors.
+    auto a = AngleArray(2);
+    assert(a.size() == 2);
+    assert(fcmp(a[0], 0));
+    a.push_back(Angle::degrees(90));
+    assert(a.size() == 3);
+    assert(fcmp(a[2], M_PI_2));
+    assert(AngleArray().size() == 0);
+}
+
+#endif
@@ -0,0 +1,61 @@
+#pragma once
+
+#include "aligned.hpp"
+#include "angle.hpp"
+
+#include <cstddef>
+
+/// Models a contiguous array of angles (structure of arrays).
+/// @discussion Angles are stored as radians in the range 0..2π, in a cache-line aligned buffer.
+/// Batch operations run on SIMD lanes (@see simd.hpp) and agree with the scalar @c Angle path:
+/// conversions within 2 ulp of 2π; sin and cos within 1 ulp, tan within 2 ulp, and atan within 1 ulp of libm.
+class AngleArray
+{
+public:
+    /// Construct an empty array.
+    AngleArray();
+
+    /// Construct an array of @c size empty angles (zero radians).
+    explicit AngleArray(std::size_t size);
+
+    /// Construct angles from @c size radians.
+    static AngleArray radians(const double * rad, std::size_t size);
+
+    /// Construct angles from @c size degrees.
+    static AngleArray degrees(const double * deg, std::size_t size);
+
+    /// Construct angles from the arc tangents of @c size ratios.
+    static AngleArray atan(const double * x, std::size_t size);
+
+    /// @return std::size_t Number of angles.
+    std::size_t size() const;
+
+    /// @return const double * Radians.
+    const double * data() const;
+
+    /// @return Angle The angle at @c index.
+    Angle operator[](std::size_t index) const;
+
+    /// Append @c angle.
+    void push_back(const Angle & angle);
+
+    /// Store radians to @c out.
+    void rad(double * out) const;
+
+    /// Store degrees to @c out.
+    void deg(double * out) const;
+
+    /// Store sines to @c out.
+    void sin(double * out) const;
+
+    /// Store cosines to @c out.
+    void cos(double * out) const;
+
+    /// Store tangents to @c out.
+    void tan(double * out) const;
+
+private:
+    friend class VectorArray;
+
+    AlignedVector<double> rad_;
+};
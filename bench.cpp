@@ -0,0 +1,1238 @@
+#include "angle.hpp"
+#include "anglearray.hpp"
+#include "binaryangle.hpp"
+#include "dataset.hpp"
+#include "equilateraltriangle.hpp"
+#include "fcmp.hpp"
+#include "format.hpp"
+#include "geometry.hpp"
+#include "isoscelestriangle.hpp"
+#include "path.hpp"
+#include "point.hpp"
+#include "pointset.hpp"
+#include "rightangledtriangle.hpp"
+#include "threadpool.hpp"
+#include "triangle.hpp"
+#include "trianglebatch.hpp"
+#include "trianglereader.hpp"
+#include "transform.hpp"
+#include "trig.hpp"
+#include "unitangle.hpp"
+#include "vector.hpp"
+#include "vectorarray.hpp"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+namespace
+{
+
+/// Keep @c value, so that computing it is not optimised away.
+template <typename T>
+inline void keep(const T & value)
+{
+    asm volatile("" : : "g"(&value) : "memory");
+}
+
+/// @return std::uint64_t Time stamp counter, or zero where there is none.
+inline std::uint64_t ticks()
+{
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    return 0;
+#endif
+}
+
+/// Times benchmarks, and reports them as a table (to stderr) and as JSON.
+/// @discussion Each benchmark is warmed up, calibrated to run for about 10 ms per sample, and then sampled 15
+/// times (or 2 ms and 5 times, if quick). Times are reported per operation: the median, the minimum and the
+/// standard deviation of the samples, with the median rate and time stamp counter ticks (cycles at the nominal
+/// frequency).
+class Harness
+{
+public:
+    /// Construct harness running benchmarks whose names contain any of @c filters (or all, if none).
+    Harness(std::vector<std::string> filters, bool quick);
+
+    /// Time @c f, which performs @c ops operations of @c unit per call.
+    template <typename F>
+    void run(const std::string & name, double ops, F f, const char * unit = "op");
+
+    /// Write results as JSON to @c file.
+    void json(std::FILE * file) const;
+
+private:
+    struct Result
+    {
+        std::string name;
+        const char * unit;
+        std::size_t iterations;
+        double median;
+        double min;
+        double stddev;
+        double cycles;
+    };
+
+    std::vector<std::string> filters_;
+    std::chrono::nanoseconds sample_;
+    std::size_t samples_;
+    std::vector<Result> results_;
+};
+
+Harness::Harness(std::vector<std::string> filters, bool quick)
+    : filters_{std::move(filters)}, sample_{quick ? 2000000 : 10000000}, samples_{quick ? 5u : 15u}, results_{}
+{
+    std::fprintf(stderr, "%-52s %12s %12s %14s %10s\n", "benchmark", "ns/op", "± %", "ops/s", "cycles/op");
+}
+
+template <typename F>
+void Harness::run(const std::string & name, double ops, F f, const char * unit)
+{
+    if (!filters_.empty() && std::none_of(filters_.begin(), filters_.end(), [&](const std::string & filter) {
+            return name.find(filter) != std::string::npos;
+        })) {
+        return;
+    }
+
+    using Clock = std::chrono::steady_clock;
+
+    // Warm up, doubling iterations until a run fills half a sample.
+    std::size_t iterations = 1;
+    for (;;) {
+        auto start = Clock::now();
+        for (std::size_t i = 0; i < iterations; ++i) {
+            f();
+        }
+        auto elapsed = Clock::now() - start;
+        if (elapsed * 2 >= sample_) {
+            auto scale = static_cast<double>(sample_.count()) / std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count();
+            iterations = std::max<std::size_t>(1, iterations * scale);
+            break;
+        }
+        iterations *= 2;
+    }
+
+    std::vector<double> ns(samples_), cycles(samples_);
+    for (std::size_t s = 0; s < samples_; ++s) {
+        auto start = Clock::now();
+        auto t = ticks();
+        for (std::size_t i = 0; i < iterations; ++i) {
+            f();
+        }
+        auto c = ticks() - t;
+        auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count();
+        ns[s] = elapsed / (iterations * ops);
+        cycles[s] = c / (iterations * ops);
+    }
+
+    auto mean = 0.;
+    for (auto x : ns) {
+        mean += x / samples_;
+    }
+    auto variance = 0.;
+    for (auto x : ns) {
+        variance += (x - mean) * (x - mean) / samples_;
+    }
+
+    std::sort(ns.begin(), ns.end());
+    std::sort(cycles.begin(), cycles.end());
+    Result r{name, unit, iterations, ns[samples_ / 2], ns[0], std::sqrt(variance), cycles[samples_ / 2]};
+    results_.push_back(r);
+
+    std::fprintf(stderr, "%-52s %12.3f %12.1f %14.4g %10.1f%s%s\n", name.c_str(), r.median, 100 * r.stddev / r.median,
+                 1e9 / r.median, r.cycles, std::strcmp(unit, "op") ? "  per " : "", std::strcmp(unit, "op") ? unit : "");
+}
+
+void Harness::json(std::FILE * file) const
+{
+    std::fprintf(file, "{\n  \"samples\": %zu,\n  \"benchmarks\": [", samples_);
+    for (std::size_t i = 0; i < results_.size(); ++i) {
+        auto & r = results_[i];
+        std::fprintf(file,
+                     "%s\n    {\"name\": \"%s\", \"unit\": \"%s\", \"iterations\": %zu, \"ns_per_op\": %.6g, "
+                     "\"ns_per_op_min\": %.6g, \"ns_per_op_stddev\": %.6g, \"ops_per_second\": %.6g, "
+                     "\"cycles_per_op\": %.6g}",
+                     i ? "," : "", r.name.c_str(), r.unit, r.iterations, r.median, r.min, r.stddev, 1e9 / r.median,
+                     r.cycles);
+    }
+    std::fprintf(file, "\n  ]\n}\n");
+}
+
+/// Elements per batch.
+constexpr std::size_t N = 1024;
+
+/// @return std::vector<double> @c size numbers uniformly in @c lo..hi.
+std::vector<double> uniform(std::size_t size, double lo, double hi, unsigned seed = 1)
+{
+    std::mt19937_64 random(seed);
+    std::uniform_real_distribution<double> d(lo, hi);
+    std::vector<double> v(size);
+    for (auto & x : v) {
+        x = d(random);
+    }
+    return v;
+}
+
+/// Sides of @c size valid triangles.
+struct Sides
+{
+    std::vector<double> a;
+    std::vector<double> b;
+    std::vector<double> c;
+};
+
+Sides sides(std::size_t size)
+{
+    auto a = uniform(size, 1, 10, 2);
+    auto b = uniform(size, 1, 10, 3);
+    auto t = uniform(size, 0.05, 0.95, 4);
+    std::vector<double> c(size);
+    for (std::size_t i = 0; i < size; ++i) {
+        auto lo = std::fabs(a[i] - b[i]);
+        c[i] = lo + (a[i] + b[i] - lo) * t[i];
+    }
+    return {a, b, c};
+}
+
+void benchAngle(Harness & h)
+{
+    auto rad = uniform(N, -10, 10);
+    auto deg = uniform(N, -720, 720);
+    std::vector<Angle> angles;
+    for (auto x : rad) {
+        angles.push_back(Angle::radians(x));
+    }
+
+    h.run("Angle::radians", N, [&] {
+        for (auto x : rad) {
+            keep(Angle::radians(x));
+        }
+    });
+    h.run("Angle::degrees", N, [&] {
+        for (auto x : deg) {
+            keep(Angle::degrees(x));
+        }
+    });
+    h.run("Angle::rad", N, [&] {
+        for (auto & a : angles) {
+            keep(a.rad());
+        }
+    });
+    h.run("Angle::deg", N, [&] {
+        for (auto & a : angles) {
+            keep(a.deg());
+        }
+    });
+    h.run("Angle::operator+", N, [&] {
+        for (std::size_t i = 1; i < N; ++i) {
+            keep(angles[i] + angles[i - 1]);
+        }
+    });
+    h.run("Angle::operator-", N, [&] {
+        for (std::size_t i = 1; i < N; ++i) {
+            keep(angles[i] - angles[i - 1]);
+        }
+    });
+    h.run("Angle::operator/", N, [&] {
+        for (auto & a : angles) {
+            keep(a / 3.);
+        }
+    });
+    h.run("Angle::operator%", N, [&] {
+        for (std::size_t i = 1; i < N; ++i) {
+            keep(angles[i] % angles[i - 1]);
+        }
+    });
+    h.run("Angle::operator+=", N, [&] {
+        auto sum = Angle();
+        for (auto & a : angles) {
+            sum += a;
+        }
+        keep(sum);
+    });
+
+    // Range reduction latency is flat in the magnitude.
+    for (auto magnitude : {1e-12, 1e-3, 1., 1e3, 1e6, 1e9, 1e12, 1e15}) {
+        auto x = uniform(N, magnitude, 2 * magnitude, 5);
+        char name[64];
+        std::snprintf(name, sizeof name, "Angle::radians/magnitude:%g", magnitude);
+        h.run(name, N, [&] {
+            for (auto r : x) {
+                keep(Angle::radians(r));
+            }
+        });
+    }
+}
+
+void benchBinaryAngle(Harness & h)
+{
+    auto rad = uniform(N, -10, 10);
+    auto deg = uniform(N, -720, 720);
+    std::vector<BinaryAngle32> angles;
+    std::vector<BinaryAngle64> angles64;
+    for (auto x : rad) {
+        angles.push_back(BinaryAngle32::radians(x));
+        angles64.push_back(BinaryAngle64::radians(x));
+    }
+
+    h.run("BinaryAngle32::radians", N, [&] {
+        for (auto x : rad) {
+            keep(BinaryAngle32::radians(x));
+        }
+    });
+    h.run("BinaryAngle32::degrees", N, [&] {
+        for (auto x : deg) {
+            keep(BinaryAngle32::degrees(x));
+        }
+    });
+    h.run("BinaryAngle32::rad", N, [&] {
+        for (auto & a : angles) {
+            keep(a.rad());
+        }
+    });
+    h.run("BinaryAngle32::operator+=", N, [&] {
+        auto sum = BinaryAngle32();
+        for (auto & a : angles) {
+            sum += a;
+        }
+        keep(sum);
+    });
+    h.run("BinaryAngle32::sin", N, [&] {
+        for (auto & a : angles) {
+            keep(a.sin());
+        }
+    });
+    h.run("BinaryAngle32::cos", N, [&] {
+        for (auto & a : angles) {
+            keep(a.cos());
+        }
+    });
+    h.run("BinaryAngle64::operator+=", N, [&] {
+        auto sum = BinaryAngle64();
+        for (auto & a : angles64) {
+            sum += a;
+        }
+        keep(sum);
+    });
+}
+
+void benchUnitAngle(Harness & h)
+{
+    auto rad = uniform(N, -10, 10);
+    auto c = uniform(N, 1, 10, 17);
+    std::vector<Angle> angles;
+    std::vector<UnitAngle> units;
+    for (auto x : rad) {
+        angles.push_back(Angle::radians(x));
+        units.push_back(UnitAngle::radians(x));
+    }
+    auto u = Vector(Point{3, 4});
+
+    // Each pair: an angle, recomputing sine and cosine per use, against a unit angle reading its cached pair.
+    h.run("Angle::sin+cos", N, [&] {
+        for (auto & a : angles) {
+            keep(std::sin(a.rad()) + std::cos(a.rad()));
+        }
+    });
+    h.run("UnitAngle::sin+cos", N, [&] {
+        for (auto & a : units) {
+            keep(a.sin() + a.cos());
+        }
+    });
+    h.run("UnitAngle::operator+=", N, [&] {
+        auto sum = UnitAngle();
+        for (auto & a : units) {
+            sum += a;
+        }
+        keep(sum);
+    });
+    h.run("Vector(Angle,magnitude)", N, [&] {
+        for (std::size_t i = 0; i < N; ++i) {
+            keep(Vector(angles[i], c[i]));
+        }
+    });
+    h.run("Vector(UnitAngle,magnitude)", N, [&] {
+        for (std::size_t i = 0; i < N; ++i) {
+            keep(Vector(units[i], c[i]));
+        }
+    });
+    h.run("Vector::rotate(Angle)", N, [&] {
+        for (auto & a : angles) {
+            keep(Vector::rotate(u, a));
+        }
+    });
+    h.run("Vector::rotate(UnitAngle)", N, [&] {
+        for (auto & a : units) {
+            keep(Vector::rotate(u, a));
+        }
+    });
+    h.run("Transform::rotate(Angle)", N, [&] {
+        auto m = Transform();
+        for (auto & a : angles) {
+            m.rotate(a);
+        }
+        keep(m);
+    });
+    h.run("Transform::rotate(UnitAngle)", N, [&] {
+        auto m = Transform();
+        for (auto & a : units) {
+            m.rotate(a);
+        }
+        keep(m);
+    });
+    h.run("RightAngledTriangle::with_A_c(Angle)", N, [&] {
+        for (std::size_t i = 0; i < N; ++i) {
+            keep(RightAngledTriangle::with_A_c(angles[i], c[i]));
+        }
+    });
+    h.run("RightAngledTriangle::with_A_c(UnitAngle)", N, [&] {
+        for (std::size_t i = 0; i < N; ++i) {
+            keep(RightAngledTriangle::with_A_c(units[i], c[i]));
+        }
+    });
+}
+
+void benchAngleArray(Harness & h)
+{
+    auto rad = uniform(N, -10, 10);
+    auto deg = uniform(N, -720, 720);
+    auto ratio = uniform(N, -10, 10);
+    auto a = AngleArray::radians(rad.data(), N);
+    std::vector<double> out(N);
+
+    h.run("AngleArray::radians", N, [&] {
+        keep(AngleArray::radians(rad.data(), N));
+    });
+    h.run("AngleArray::degrees", N, [&] {
+        keep(AngleArray::degrees(deg.data(), N));
+    });
+    h.run("AngleArray::atan", N, [&] {
+        keep(AngleArray::atan(ratio.data(), N));
+    });
+    h.run("AngleArray::rad", N, [&] {
+        a.rad(out.data());
+        keep(out);
+    });
+    h.run("AngleArray::deg", N, [&] {
+        a.deg(out.data());
+        keep(out);
+    });
+    h.run("AngleArray::sin", N, [&] {
+        a.sin(out.data());
+        keep(out);
+    });
+    h.run("AngleArray::cos", N, [&] {
+        a.cos(out.data());
+        keep(out);
+    });
+    h.run("AngleArray::tan", N, [&] {
+        a.tan(out.data());
+        keep(out);
+    });
+}
+
+template <typename Trig>
+void benchPolicy(Harness & h, const char * tier)
+{
+    auto x = uniform(N, -10, 10);
+    auto u = uniform(N, -1, 1);
+    auto s = sides(N);
+    auto A = uniform(N, 0.1, 1.4);
+    auto name = [&](const char * f) {
+        return std::string("trig::") + tier + "::" + f;
+    };
+
+    h.run(name("sin"), N, [&] {
+        for (auto v : x) {
+            keep(Trig::sin(v));
+        }
+    });
+    h.run(name("cos"), N, [&] {
+        for (auto v : x) {
+            keep(Trig::cos(v));
+        }
+    });
+    h.run(name("tan"), N, [&] {
+        for (auto v : x) {
+            keep(Trig::tan(v));
+        }
+    });
+    h.run(name("asin"), N, [&] {
+        for (auto v : u) {
+            keep(Trig::asin(v));
+        }
+    });
+    h.run(name("acos"), N, [&] {
+        for (auto v : u) {
+            keep(Trig::acos(v));
+        }
+    });
+    h.run(name("atan"), N, [&] {
+        for (auto v : x) {
+            keep(Trig::atan(v));
+        }
+    });
+    h.run(name("RightAngledTriangle::with_A_c"), N, [&] {
+        for (std::size_t i = 0; i < N; ++i) {
+            keep(RightAngledTriangle::with_A_c<Trig>(Angle::radians(A[i]), s.c[i]));
+        }
+    });
+    h.run(name("Triangle::with_a_b_c/all-angles"), N, [&] {
+        for (std::size_t i = 0; i < N; ++i) {
+            keep(Triangle::with_a_b_c<Trig>(s.a[i], s.b[i], s.c[i]).B());
+        }
+    });
+}
+
+void benchTrig(Harness & h)
+{
+    benchPolicy<trig::Libm>(h, "Libm");
+    benchPolicy<trig::Minimax<3>>(h, "Minimax<3>");
+    benchPolicy<trig::Minimax<4>>(h, "Minimax<4>");
+    benchPolicy<trig::Minimax<5>>(h, "Minimax<5>");
+    benchPolicy<trig::Table<256>>(h, "Table<256>");
+    benchPolicy<trig::Table<4096>>(h, "Table<4096>");
+}
+
+void benchPoint(Harness & h)
+{
+    auto x = uniform(N, -100, 100, 6);
+    auto y = uniform(N, -100, 100, 7);
+    std::vector<Point> points;
+    for (std::size_t i = 0; i < N; ++i) {
+        points.emplace_back(x[i], y[i]);
+    }
+
+    h.run("Point::Point", N, [&] {
+        for (std::size_t i = 0; i < N; ++i) {
+            keep(Point(x[i], y[i]));
+        }
+    });
+    h.run("Point::operator+", N, [&] {
+        for (std::size_t i = 1; i < N; ++i) {
+            keep(points[i] + points[i - 1]);
+        }
+    });
+    h.run("Point::operator-", N, [&] {
+        for (std::size_t i = 1; i < N; ++i) {
+            keep(points[i] - points[i - 1]);
+        }
+    });
+    h.run("Point::operator==", N, [&] {
+        for (std::size_t i = 1; i < N; ++i) {
+            keep(points[i] == points[i - 1]);
+        }
+    });
+}
+
+void benchVector(Harness & h)
+{
+    auto x = uniform(N, -100, 100, 8);
+    auto y = uniform(N, -100, 100, 9);
+    auto rad = uniform(N, -10, 10, 10);
+    auto mag = uniform(N, 0, 100, 11);
+    std::vector<Vector> vectors;
+    for (std::size_t i = 0; i < N; ++i) {
+        vectors.push_back(Vector(Point(x[i], y[i]), Point(y[i], x[i])));
+    }
+    auto turn = Angle::degrees(33);
+
+    h.run("Vector::Vector(head)", N, [&] {
+        for (std::size_t i = 0; i < N; ++i) {
+            keep(Vector(Point(x[i], y[i])));
+        }
+    });
+    h.run("Vector::Vector(tail,head)", N, [&] {
+        for (std::size_t i = 0; i < N; ++i) {
+            keep(Vector(Point(x[i], y[i]), Point(y[i], x[i])));
+        }
+    });
+    h.run("Vector::Vector(direction,magnitude)", N, [&] {
+        for (std::size_t i = 0; i < N; ++i) {
+            keep(Vector(Angle::radians(rad[i]), mag[i]));
+        }
+    });
+    h.run("Vector::rotate(static)", N, [&] {
+        for (auto & v : vectors) {
+            keep(Vector::rotate(v, turn));
+        }
+    });
+    h.run("Vector::rotate", N, [&] {
+        for (auto v : vectors) {
+            keep(v.rotate(turn));
+        }
+    });
+    h.run("Vector::translate(static)", N, [&] {
+        for (std::size_t i = 0; i < N; ++i) {
+            keep(Vector::translate(vectors[i], Point(y[i], x[i])));
+        }
+    });
+    h.run("Vector::translate", N, [&] {
+        for (std::size_t i = 0; i < N; ++i) {
+            auto v = vectors[i];
+            keep(v.translate(Point(y[i], x[i])));
+        }
+    });
+    // A pose pipeline: three steps per vector, or one transform built once.
+    auto offset = Point(3, -4);
+    auto back = Angle::degrees(-45);
+    h.run("Vector::rotate.translate.rotate", N, [&] {
+        for (auto v : vectors) {
+            keep(v.rotate(turn).translate(offset).rotate(back));
+        }
+    });
+    h.run("Transform::apply(Vector)", N, [&] {
+        auto m = Transform().rotate(turn).translate(offset).rotate(back);
+        for (auto & v : vectors) {
+            keep(m.apply(v));
+        }
+    });
+    h.run("Vector::tail", N, [&] {
+        for (auto & v : vectors) {
+            keep(v.tail());
+        }
+    });
+    h.run("Vector::head", N, [&] {
+        for (auto & v : vectors) {
+            keep(v.head());
+        }
+    });
+    h.run("Vector::direction", N, [&] {
+        for (auto & v : vectors) {
+            keep(v.direction());
+        }
+    });
+    h.run("Vector::magnitude", N, [&] {
+        for (auto & v : vectors) {
+            keep(v.magnitude());
+        }
+    });
+}
+
+void benchVectorArray(Harness & h)
+{
+    auto x = uniform(N, -100, 100, 12);
+    auto y = uniform(N, -100, 100, 13);
+    auto rad = uniform(N, -10, 10, 14);
+    auto mag = uniform(N, 0, 100, 15);
+    auto directions = AngleArray::radians(rad.data(), N);
+    VectorArray a;
+    std::vector<Point> points;
+    for (std::size_t i = 0; i < N; ++i) {
+        a.push_back(Vector(Point(x[i], y[i]), Point(y[i], x[i])));
+        points.emplace_back(x[i], y[i]);
+    }
+    std::vector<double> outX(N), outY(N);
+    auto origin = Point(1, -2);
+    auto turn = Angle::degrees(33);
+
+    h.run("VectorArray::polar(AngleArray)", N, [&] {
+        keep(VectorArray::polar(directions, mag.data()));
+    });
+    h.run("VectorArray::polar", N, [&] {
+        VectorArray::polar(rad.data(), mag.data(), N, outX.data(), outY.data());
+        keep(outX);
+    });
+    h.run("VectorArray::rotate(columns)", N, [&] {
+        VectorArray::rotate(x.data(), y.data(), N, origin, turn, outX.data(), outY.data());
+        keep(outX);
+    });
+    h.run("VectorArray::rotate(points)", N, [&] {
+        VectorArray::rotate(points.data(), N, origin, turn);
+        keep(points);
+    });
+    h.run("VectorArray::rotate", N, [&] {
+        keep(a.rotate(turn));
+    });
+    auto pose = Transform().rotate(turn).translate(origin).rotate(turn);
+    h.run("VectorArray::apply(columns)", N, [&] {
+        VectorArray::apply(x.data(), y.data(), N, pose, outX.data(), outY.data());
+        keep(outX);
+    });
+    h.run("VectorArray::apply(points)", N, [&] {
+        VectorArray::apply(points.data(), N, pose);
+        keep(points);
+    });
+    h.run("VectorArray::apply", N, [&] {
+        keep(a.apply(pose));
+    });
+    h.run("VectorArray::direction", N, [&] {
+        keep(a.direction());
+    });
+    h.run("VectorArray::magnitude", N, [&] {
+        a.magnitude(outX.data());
+        keep(outX);
+    });
+    h.run("VectorArray::operator[]", N, [&] {
+        for (std::size_t i = 0; i < N; ++i) {
+            keep(a[i]);
+        }
+    });
+}
+
+void benchPath(Harness & h)
+{
+    auto turns = uniform(N, -90, 90, 16);
+    auto lengths = uniform(N, 0, 10, 17);
+    auto path = Path();
+    for (std::size_t i = 0; i < N; ++i) {
+        path.add(Angle::degrees(turns[i]), lengths[i]);
+    }
+    std::vector<Point> vertices(N + 1);
+
+    // Per segment: walking by chaining vectors, against the one-pass path.
+    h.run("Vector::rotate.translate(walk)", N, [&] {
+        auto v = Vector(Point(1, 0));
+        for (std::size_t i = 0; i < N; ++i) {
+            v = Vector(Angle::degrees(turns[i]), lengths[i]).rotate(v.direction()).translate(v.head());
+        }
+        keep(v);
+    });
+    h.run("Path::add", N, [&] {
+        auto p = Path();
+        for (std::size_t i = 0; i < N; ++i) {
+            p.add(Angle::degrees(turns[i]), lengths[i]);
+        }
+        keep(p);
+    });
+    h.run("Path::vertices", N, [&] {
+        path.vertices(vertices.data());
+        keep(vertices);
+    });
+
+    // Per path: closure of many short paths.
+    constexpr std::size_t PATHS = 1 << 14;
+    std::vector<Path> paths;
+    for (std::size_t i = 0; i < PATHS; ++i) {
+        auto p = Path();
+        for (std::size_t j = 0; j < 8; ++j) {
+            p.add(Angle::degrees(turns[(i + j) % N]), lengths[(i * 8 + j) % N]);
+        }
+        paths.push_back(p);
+    }
+    std::vector<double> closures(PATHS);
+    h.run("Path::closure(batch)", PATHS, [&] {
+        Path::closure(paths.data(), PATHS, closures.data());
+        keep(closures);
+    });
+    h.run("Path::closure(pool)", PATHS, [&] {
+        Path::closure(ThreadPool::shared(), paths.data(), PATHS, closures.data());
+        keep(closures);
+    });
+}
+
+void benchRightAngledTriangle(Harness & h)
+{
+    auto a = uniform(N, 1, 10, 16);
+    auto b = uniform(N, 1, 10, 17);
+    auto A = uniform(N, 0.1, 1.4, 18);
+    std::vector<RightAngledTriangle> triangles;
+    for (std::size_t i = 0; i < N; ++i) {
+        triangles.push_back(RightAngledTriangle::with_a_b(a[i], b[i]));
+    }
+
+    h.run("RightAngledTriangle::with_a_b", N, [&] {
+        for (std::size_t i = 0; i < N; ++i) {
+            keep(RightAngledTriangle::with_a_b(a[i], b[i]));
+        }
+    });
+    h.run("RightAngledTriangle::with_a_c", N, [&] {
+        for (std::size_t i = 0; i < N; ++i) {
+            keep(RightAngledTriangle::with_a_c(a[i], a[i] + b[i]));
+        }
+    });
+    h.run("RightAngledTriangle::with_A_c", N, [&] {
+        for (std::size_t i = 0; i < N; ++i) {
+            keep(RightAngledTriangle::with_A_c(Angle::radians(A[i]), b[i]));
+        }
+    });
+    h.run("RightAngledTriangle::with_a", N, [&] {
+        for (std::size_t i = 0; i < N; ++i) {
+            keep(RightAngledTriangle::with_a(triangles[i], b[i]));
+        }
+    });
+    h.run("RightAngledTriangle::with_b", N, [&] {
+        for (std::size_t i = 0; i < N; ++i) {
+            keep(RightAngledTriangle::with_b(triangles[i], b[i]));
+        }
+    });
+    h.run("RightAngledTriangle::with_c", N, [&] {
+        for (std::size_t i = 0; i < N; ++i) {
+            keep(RightAngledTriangle::with_c(triangles[i], b[i]));
+        }
+    });
+    h.run("RightAngledTriangle::scaled", N, [&] {
+        for (std::size_t i = 0; i < N; ++i) {
+            keep(RightAngledTriangle::scaled(triangles[i], b[i]));
+        }
+    });
+    h.run("RightAngledTriangle::similar_c", N, [&] {
+        for (std::size_t i = 0; i < N; ++i) {
+            keep(RightAngledTriangle::similar_c(triangles[i], b[i]));
+        }
+    });
+
+    // Level of detail: a family of hypotenuses against one reference triangle.
+    auto reference = triangles[0];
+    std::vector<RightAngledTriangle> family(N, reference);
+    h.run("RightAngledTriangle::with_c(family)", N, [&] {
+        for (std::size_t i = 0; i < N; ++i) {
+            family[i] = RightAngledTriangle::with_c(reference, b[i]);
+        }
+        keep(family);
+    });
+    h.run("RightAngledTriangle::similar_c(family)", N, [&] {
+        for (std::size_t i = 0; i < N; ++i) {
+            family[i] = RightAngledTriangle::similar_c(reference, b[i]);
+        }
+        keep(family);
+    });
+    h.run("RightAngledTriangle::similar_c(batch)", N, [&] {
+        RightAngledTriangle::similar_c(reference, b.data(), N, family.data());
+        keep(family);
+    });
+    h.run("RightAngledTriangle::A+B+sides", N, [&] {
+        for (auto & t : triangles) {
+            keep(t.A().rad() + t.B().rad() + t.a() + t.b() + t.c());
+        }
+    });
+}
+
+void benchTriangle(Harness & h)
+{
+    auto s = sides(N);
+    auto A = uniform(N, 0.1, 1.4, 19);
+    auto B = uniform(N, 0.1, 1.4, 20);
+    std::vector<Triangle> triangles;
+    for (std::size_t i = 0; i < N; ++i) {
+        triangles.push_back(Triangle(s.a[i], s.b[i], s.c[i]));
+        triangles.back().B();
+    }
+
+    // Angles are solved lazily, so access patterns that need fewer angles cost less.
+    h.run("Triangle::Triangle/sides-only", N, [&] {
+        for (std::size_t i = 0; i < N; ++i) {
+            auto t = Triangle(s.a[i], s.b[i], s.c[i]);
+            keep(t.a() + t.b() + t.c());
+        }
+    });
+    h.run("Triangle::Triangle/C", N, [&] {
+        for (std::size_t i = 0; i < N; ++i) {
+            keep(Triangle(s.a[i], s.b[i], s.c[i]).C());
+        }
+    });
+    h.run("Triangle::Triangle/A", N, [&] {
+        for (std::size_t i = 0; i < N; ++i) {
+            keep(Triangle(s.a[i], s.b[i], s.c[i]).A());
+        }
+    });
+    h.run("Triangle::Triangle/all-angles", N, [&] {
+        for (std::size_t i = 0; i < N; ++i) {
+            auto t = Triangle(s.a[i], s.b[i], s.c[i]);
+            keep(t.A().rad() + t.B().rad() + t.C().rad());
+        }
+    });
+    h.run("Triangle::with_a_b_c", N, [&] {
+        for (std::size_t i = 0; i < N; ++i) {
+            keep(Triangle::with_a_b_c(s.a[i], s.b[i], s.c[i]));
+        }
+    });
+    h.run("Triangle::with_a_b_C", N, [&] {
+        for (std::size_t i = 0; i < N; ++i) {
+            keep(Triangle::with_a_b_C(s.a[i], s.b[i], Angle::radians(A[i])));
+        }
+    });
+    h.run("Triangle::with_A_B_c/all-angles", N, [&] {
+        for (std::size_t i = 0; i < N; ++i) {
+            auto t = Triangle::with_A_B_c(Angle::radians(A[i]), Angle::radians(B[i]), s.c[i]);
+            keep(t.A().rad() + t.B().rad() + t.C().rad());
+        }
+    });
+    h.run("Triangle::A+B+C/cached", N, [&] {
+        for (auto & t : triangles) {
+            keep(t.A().rad() + t.B().rad() + t.C().rad());
+        }
+    });
+    h.run("Triangle::subA", N, [&] {
+        for (auto & t : triangles) {
+            keep(t.subA());
+        }
+    });
+    h.run("Triangle::subB", N, [&] {
+        for (auto & t : triangles) {
+            keep(t.subB());
+        }
+    });
+}
+
+void benchSpecialTriangles(Harness & h)
+{
+    auto V = uniform(N, 0.1, 3, 21);
+    auto side = uniform(N, 1, 10, 22);
+    std::vector<IsoscelesTriangle> isosceles;
+    for (std::size_t i = 0; i < N; ++i) {
+        isosceles.push_back(IsoscelesTriangle(Angle::radians(V[i]), side[i]));
+    }
+
+    h.run("IsoscelesTriangle::IsoscelesTriangle", N, [&] {
+        for (std::size_t i = 0; i < N; ++i) {
+            keep(IsoscelesTriangle(Angle::radians(V[i]), side[i]));
+        }
+    });
+    h.run("IsoscelesTriangle::base/first", N, [&] {
+        for (std::size_t i = 0; i < N; ++i) {
+            keep(IsoscelesTriangle(Angle::radians(V[i]), side[i]).base());
+        }
+    });
+
+    // Base, height and base angle are cached, so repeated calls cost a load.
+    h.run("IsoscelesTriangle::base+height/repeated", N, [&] {
+        for (auto & t : isosceles) {
+            keep(t.base() + t.height());
+        }
+    });
+    h.run("IsoscelesTriangle::vertexAngle+baseAngle", N, [&] {
+        for (auto & t : isosceles) {
+            keep(t.vertexAngle().rad() + t.baseAngle().rad() + t.side());
+        }
+    });
+
+    h.run("EquilateralTriangle::EquilateralTriangle", N, [&] {
+        for (auto s : side) {
+            keep(EquilateralTriangle(s));
+        }
+    });
+    h.run("EquilateralTriangle::height", N, [&] {
+        for (auto s : side) {
+            auto t = EquilateralTriangle(s);
+            keep(t.height() + t.angle().rad() + t.side());
+        }
+    });
+}
+
+/// Benchmark @c description against @c format_to, for @c values.
+template <typename T>
+void benchDescription(Harness & h, const char * type, const std::vector<T> & values)
+{
+    h.run(std::string(type) + "::description", values.size(), [&] {
+        for (auto & v : values) {
+            keep(v.description());
+        }
+    });
+    h.run(std::string(type) + "::format_to", values.size(), [&] {
+        char buffer[DESCRIPTION_SIZE];
+        for (auto & v : values) {
+            keep(v.format_to(buffer, sizeof buffer));
+            keep(buffer);
+        }
+    });
+}
+
+void benchFormat(Harness & h)
+{
+    auto x = uniform(N, -100, 100, 23);
+    auto y = uniform(N, 1, 10, 24);
+    auto s = sides(N);
+    std::vector<Point> points;
+    std::vector<Vector> vectors;
+    std::vector<Triangle> triangles;
+    std::vector<RightAngledTriangle> right;
+    std::vector<IsoscelesTriangle> isosceles;
+    std::vector<EquilateralTriangle> equilateral;
+    for (std::size_t i = 0; i < N; ++i) {
+        points.emplace_back(x[i], y[i]);
+        vectors.push_back(Vector(Point(y[i], x[i]), Point(x[i], y[i])));
+        triangles.push_back(Triangle(s.a[i], s.b[i], s.c[i]));
+        right.push_back(RightAngledTriangle::with_a_b(s.a[i], s.b[i]));
+        isosceles.push_back(IsoscelesTriangle(Angle::radians(s.a[i] / 4), y[i]));
+        equilateral.push_back(EquilateralTriangle(y[i]));
+    }
+
+    benchDescription(h, "Point", points);
+    benchDescription(h, "Vector", vectors);
+    benchDescription(h, "Triangle", triangles);
+    benchDescription(h, "RightAngledTriangle", right);
+    benchDescription(h, "IsoscelesTriangle", isosceles);
+    benchDescription(h, "EquilateralTriangle", equilateral);
+}
+
+void benchFcmp(Harness & h)
+{
+    auto x = uniform(N, -10, 10, 25);
+    auto y = x;
+    auto jitter = uniform(N, -0.001, 0.001, 26);
+    for (std::size_t i = 0; i < N; ++i) {
+        y[i] += jitter[i];
+    }
+    std::vector<std::uint64_t> mask(N / 64);
+
+    h.run("fcmp(x,y,precision)", N, [&] {
+        for (std::size_t i = 0; i < N; ++i) {
+            keep(fcmp(x[i], y[i], 3));
+        }
+    });
+    h.run("fcmp<3>", N, [&] {
+        for (std::size_t i = 0; i < N; ++i) {
+            keep(fcmp<3>(x[i], y[i]));
+        }
+    });
+    h.run("fcmp(batch)", N, [&] {
+        fcmp(x.data(), y.data(), N, mask.data(), 3);
+        keep(mask);
+    });
+    h.run("Absolute(batch)", N, [&] {
+        Absolute{1e-3}(x.data(), y.data(), N, mask.data());
+        keep(mask);
+    });
+    h.run("Relative(batch)", N, [&] {
+        Relative{1e-3}(x.data(), y.data(), N, mask.data());
+        keep(mask);
+    });
+    h.run("Ulp", N, [&] {
+        for (std::size_t i = 0; i < N; ++i) {
+            keep(Ulp{4}(x[i], y[i]));
+        }
+    });
+    h.run("Ulp(batch)", N, [&] {
+        Ulp{4}(x.data(), y.data(), N, mask.data());
+        keep(mask);
+    });
+}
+
+void benchPointSet(Harness & h)
+{
+    constexpr std::size_t SIZE = 1 << 16;
+    auto x = uniform(SIZE, -100, 100, 27);
+    auto y = uniform(SIZE, -100, 100, 28);
+    std::vector<Point> points;
+    for (std::size_t i = 0; i < SIZE; ++i) {
+        points.emplace_back(x[i], y[i]);
+    }
+    PointSet set;
+    for (auto & p : points) {
+        set.insert(p);
+    }
+
+    h.run("PointSet::insert", SIZE, [&] {
+        PointSet s;
+        s.reserve(SIZE);
+        for (auto & p : points) {
+            keep(s.insert(p));
+        }
+    });
+    h.run("PointSet::find", SIZE, [&] {
+        for (auto & p : points) {
+            keep(set.find(p));
+        }
+    });
+}
+
+void benchTriangleBatch(Harness & h)
+{
+    auto s = sides(N);
+    std::vector<double> A(N), B(N), C(N);
+    std::unique_ptr<bool[]> valid(new bool[N]);
+
+    h.run("TriangleBatch::solve", N, [&] {
+        keep(TriangleBatch::solve(s.a.data(), s.b.data(), s.c.data(), N, A.data(), B.data(), C.data(), valid.get()));
+    });
+}
+
+void benchDataset(Harness & h)
+{
+    constexpr std::size_t SIZE = 1 << 20;
+    const char * path = "bench.dataset";
+    auto x = uniform(SIZE, -100, 100, 29);
+    DatasetWriter writer;
+    for (std::size_t i = 0; i < SIZE; ++i) {
+        writer.add(Point(x[i], -x[i]));
+    }
+
+    h.run("DatasetWriter::write", SIZE, [&] {
+        keep(writer.write(path));
+    });
+
+    Dataset d;
+    h.run("Dataset::open", 1, [&] {
+        keep(d.open(path));
+    });
+
+    // Columns are read in place, at memory bandwidth.
+    h.run("Dataset::column/sum", SIZE * 2 * sizeof(double), [&] {
+        auto px = d.column(Column::PointX);
+        auto py = d.column(Column::PointY);
+        auto sum = 0.;
+        for (std::size_t i = 0; i < d.points(); ++i) {
+            sum += px[i] + py[i];
+        }
+        keep(sum);
+    }, "byte");
+    h.run("Dataset::point", SIZE, [&] {
+        for (std::size_t i = 0; i < d.points(); ++i) {
+            keep(d.point(i));
+        }
+    });
+
+    d.close();
+    std::remove(path);
+}
+
+void benchTriangleReader(Harness & h, std::size_t megabytes)
+{
+    const char * path = "bench.triangles";
+    auto file = std::fopen(path, "wb");
+    if (!file) {
+        return;
+    }
+
+    // Generate records of every kind, up to the size requested.
+    auto s = sides(N);
+    auto A = uniform(N, 10, 80, 30);
+    std::size_t bytes = 0;
+    for (std::size_t i = 0; bytes < megabytes << 20; i = (i + 1) % N) {
+        char line[128];
+        int n;
+        if (i % 3 == 0) {
+            n = std::snprintf(line, sizeof line, "sss %.6f %.6f %.6f\n", s.a[i], s.b[i], s.c[i]);
+        } else if (i % 3 == 1) {
+            n = std::snprintf(line, sizeof line, "sas %.6f %.6f %.6f\n", s.a[i], s.b[i], A[i]);
+        } else {
+            n = std::snprintf(line, sizeof line, "asa %.6f %.6f %.6f\n", A[i], 90 - A[i], s.c[i]);
+        }
+        std::fwrite(line, 1, n, file);
+        bytes += n;
+    }
+    std::fclose(file);
+
+    h.run("TriangleReader::read", bytes, [&] {
+        auto f = std::fopen(path, "rb");
+        TriangleReader reader(f);
+        std::vector<Triangle> triangles;
+        while (reader.read(triangles, N)) {
+            keep(triangles);
+        }
+        std::fclose(f);
+    }, "byte");
+
+    std::remove(path);
+}
+
+void benchThreadPool(Harness & h)
+{
+    constexpr std::size_t SIZE = 1 << 20;
+    auto s = sides(SIZE);
+    auto rad = uniform(SIZE, -10, 10, 31);
+    std::vector<double> A(SIZE), B(SIZE), C(SIZE);
+    std::unique_ptr<bool[]> valid(new bool[SIZE]);
+
+    // Scaling from one thread to one per hardware thread.
+    std::vector<std::size_t> threads;
+    auto hardware = ThreadPool::shared().size();
+    for (std::size_t t = 1; t < hardware; t *= 2) {
+        threads.push_back(t);
+    }
+    threads.push_back(hardware);
+
+    for (auto t : threads) {
+        ThreadPool pool(t);
+        auto suffix = "/threads:" + std::to_string(t);
+        h.run("ThreadPool/TriangleBatch::solve" + suffix, SIZE, [&] {
+            keep(TriangleBatch::solve(pool, s.a.data(), s.b.data(), s.c.data(), SIZE, A.data(), B.data(), C.data(),
+                                      valid.get()));
+        });
+        h.run("ThreadPool/VectorArray::polar" + suffix, SIZE, [&] {
+            VectorArray::polar(pool, rad.data(), s.a.data(), SIZE, A.data(), B.data());
+            keep(A);
+        });
+    }
+}
+
+void benchGeometry(Harness & h)
+{
+    constexpr std::size_t SIZE = 1 << 16;
+    auto s = sides(SIZE);
+    std::vector<std::array<double, 3>> triples;
+    std::vector<Vector> vectors;
+    for (std::size_t i = 0; i < SIZE; ++i) {
+        triples.push_back({s.a[i], s.b[i], s.c[i]});
+        vectors.push_back(Vector(Point(s.a[i], s.b[i])));
+    }
+    std::vector<Triangle> triangles(SIZE, Triangle(1, 1, 1));
+    std::vector<Vector> out(SIZE, Vector(Point()));
+
+    auto policies = [&](const char * name, auto f) {
+        h.run(std::string("geometry::") + name + "/seq", SIZE, [&] {
+            f(std::execution::seq);
+        });
+        h.run(std::string("geometry::") + name + "/par", SIZE, [&] {
+            f(std::execution::par);
+        });
+    };
+    policies("solve", [&](auto && policy) {
+        geometry::solve(policy, triples.begin(), triples.end(), triangles.begin());
+        keep(triangles);
+    });
+    policies("rotate", [&](auto && policy) {
+        geometry::rotate(policy, vectors.begin(), vectors.end(), out.begin(), Angle::degrees(33));
+        keep(out);
+    });
+}
+
+} // namespace
+
+/// Run benchmarks whose names contain any argument (or all), writing JSON to stdout.
+/// @discussion Options are @c --quick, for fewer and shorter samples, and @c --reader-mb=N, for the size of
+/// the file generated for @c TriangleReader (default 64).
+int main(int argc, char ** argv)
+{
+    std::vector<std::string> filters;
+    auto quick = false;
+    std::size_t megabytes = 64;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--quick") == 0) {
+            quick = true;
+        } else if (std::strncmp(argv[i], "--reader-mb=", 12) == 0) {
+            megabytes = std::strtoul(argv[i] + 12, nullptr, 10);
+        } else {
+            filters.push_back(argv[i]);
+        }
+    }
+
+    Harness h(filters, quick);
+    benchAngle(h);
+    benchBinaryAngle(h);
+    benchUnitAngle(h);
+    benchAngleArray(h);
+    benchTrig(h);
+    benchPoint(h);
+    benchVector(h);
+    benchVectorArray(h);
+    benchPath(h);
+    benchRightAngledTriangle(h);
+    benchTriangle(h);
+    benchSpecialTriangles(h);
+    benchFormat(h);
+    benchFcmp(h);
+    benchPointSet(h);
+    benchTriangleBatch(h);
+    benchDataset(h);
+    benchTriangleReader(h, megabytes);
+    benchThreadPool(h);
+    benchGeometry(h);
+    h.json(stdout);
+}
@@ -0,0 +1,230 @@
+#include "binaryangle.hpp"
+
+#include "instrument.hpp"
+#include "simd.hpp"
+
+#include <array>
+#include <cmath>
+
+namespace
+{
+
+/// Sine table entries per turn, as a power of two.
+constexpr int TABLE_BITS = 12;
+
+constexpr unsigned TABLE_SIZE = 1u << TABLE_BITS;
+
+/// Entries per quarter turn; cosine is sine a quarter turn on.
+constexpr unsigned QUARTER = TABLE_SIZE / 4;
+
+/// Sine of each entry, built from libm on the first quarter turn.
+/// @discussion The other quarters are reflections, so entries on the axes are exactly 0 or ±1.
+struct SineTable
+{
+    SineTable()
+    {
+        for (unsigned j = 0; j < TABLE_SIZE; ++j) {
+            auto r = j % QUARTER;
+            auto q = j / QUARTER;
+            auto v = std::sin((q & 1 ? QUARTER - r : r) * (M_TWOPI / TABLE_SIZE));
+            sin[j] = q & 2 ? -v : v;
+        }
+    }
+
+    std::array<double, TABLE_SIZE> sin;
+};
+
+/// @return SineTable Shared table, built on first use.
+const SineTable & table()
+{
+    static const SineTable t;
+    return t;
+}
+
+/// @return unsigned Index of the entry nearest @c steps, with sin and cos of the remainder in @c sd and @c cd.
+template <typename U>
+unsigned entry(U steps, double & sd, double & cd)
+{
+    constexpr int SHIFT = std::numeric_limits<U>::digits - TABLE_BITS;
+    constexpr U HALF = U{1} << (SHIFT - 1);
+    constexpr double STEP = M_TWOPI / (2. * HALF * TABLE_SIZE);
+
+    // Round to the nearest entry; the last half entry wraps onto entry zero.
+    auto n = static_cast<U>(steps + HALF);
+    auto d = (static_cast<double>(n & ((U{1} << SHIFT) - 1)) - static_cast<double>(HALF)) * STEP;
+    auto z = d * d;
+    sd = d * (1. - z / 6.);
+    cd = 1. - z / 2. * (1. - z / 12.);
+    return static_cast<unsigned>(n >> SHIFT);
+}
+
+/// @return double @c x rounded to the nearest whole number (ties to even), for |x| < 2^51.
+inline double whole(double x)
+{
+    return simd::nearest(x);
+}
+
+/// @return long double @c x rounded to the nearest whole number (ties to even).
+inline long double whole(long double x)
+{
+    return std::nearbyint(x);
+}
+
+} // namespace
+
+template <typename U>
+BasicBinaryAngle<U>::BasicBinaryAngle(const Angle & angle) : steps_{nearest(angle.rad() * (Wide(TURN) / TWOPI<Wide>)).steps_}
+{
+}
+
+template <typename U>
+BasicBinaryAngle<U> BasicBinaryAngle<U>::radians(double rad)
+{
+    return BasicBinaryAngle(Angle::radians(rad));
+}
+
+template <typename U>
+BasicBinaryAngle<U> BasicBinaryAngle<U>::degrees(double deg)
+{
+    // Whole turns are removed exactly in degrees, and the fraction of a turn is rounded once.
+    auto d = deg >= 0 && deg < 360 ? deg : std::fmod(deg, 360.);
+    return nearest(d * (Wide(TURN) / 360));
+}
+
+template <typename U>
+BasicBinaryAngle<U> BasicBinaryAngle<U>::nearest(Wide x)
+{
+    auto n = whole(x < 0 ? x + Wide(TURN) : x);
+    // A whole turn wraps to zero, as does NaN.
+    return BasicBinaryAngle(n < Wide(TURN) ? static_cast<U>(n) : U{0});
+}
+
+template <typename U>
+double BasicBinaryAngle<U>::sin() const
+{
+    TRIG_COUNT(TRIG);
+    double sd, cd;
+    auto i = entry(steps_, sd, cd);
+    auto & s = table().sin;
+    // sin(a + d) = sin(a)cos(d) + cos(a)sin(d)
+    return s[i] * cd + s[(i + QUARTER) % TABLE_SIZE] * sd;
+}
+
+template <typename U>
+double BasicBinaryAngle<U>::cos() const
+{
+    TRIG_COUNT(TRIG);
+    double sd, cd;
+    auto i = entry(steps_, sd, cd);
+    auto & s = table().sin;
+    // cos(a + d) = cos(a)cos(d) - sin(a)sin(d)
+    return s[(i + QUARTER) % TABLE_SIZE] * cd - s[i] * sd;
+}
+
+template class BasicBinaryAngle<std::uint32_t>;
+template class BasicBinaryAngle<std::uint64_t>;
+
+#ifdef UNITTEST_BINARYANGLE
+
+#include "fcmp.hpp"
+
+#include <cassert>
+#include <initializer_list>
+
+namespace
+{
+
+/// Check binary angles in unsigned type @c U.
+template <typename U>
+void test()
+{
+    using BinaryAngle = BasicBinaryAngle<U>;
+    constexpr U QUARTER_TURN = U{1} << (std::numeric_limits<U>::digits - 2);
+
+    static_assert(BinaryAngle().steps() == 0);
+    static_assert(BinaryAngle::with_steps(QUARTER_TURN).deg() == 90);
+    static_assert(BinaryAngle::with_steps(QUARTER_TURN).rad() == M_PI_2);
+    static_assert(BinaryAngle::with_steps(QUARTER_TURN).angle() == Angle::degrees(90));
+
+    // Wraparound is overflow.
+    constexpr auto q = BinaryAngle::with_steps(QUARTER_TURN);
+    static_assert(q * 4 == BinaryAngle());
+    static_assert(q + q + q + q == BinaryAngle());
+    static_assert(BinaryAngle() - q == q * 3);
+    static_assert(-q == q * 3);
+    static_assert(q / 2 + q / 2 == q);
+    static_assert(q != BinaryAngle());
+
+    auto a = q;
+    a += q;
+    assert(a.deg() == 180);
+    a -= q / 2;
+    assert(a.deg() == 135);
+    a *= 3;
+    assert(a.deg() == 45);
+    a /= 2;
+    assert(a.deg() == 22.5);
+
+    // Power-of-two fractions of a turn are exact.
+    assert(BinaryAngle::degrees(90) == q);
+    assert(BinaryAngle::degrees(-270) == q);
+    assert(BinaryAngle::degrees(450) == q);
+    assert(BinaryAngle::degrees(360) == BinaryAngle());
+    assert(BinaryAngle::degrees(-1e-30) == BinaryAngle());
+    assert(BinaryAngle::degrees(22.5).steps() == QUARTER_TURN / 4);
+    assert(fcmp(BinaryAngle::radians(M_PI_2).rad(), M_PI_2, 15));
+    assert(fcmp(BinaryAngle::radians(-3 * M_PI_2).rad(), M_PI_2, 15));
+    assert(fcmp(BinaryAngle(Angle::degrees(90)).rad(), M_PI_2, 15));
+    assert(BinaryAngle::degrees(NAN) == BinaryAngle());
+    assert(BinaryAngle::radians(INFINITY) == BinaryAngle());
+
+    // Conversions round to the nearest step.
+    for (double deg : {1., 33.3, 200.5, 359.999}) {
+        assert(fcmp(BinaryAngle::degrees(deg).deg(), deg, 6));
+        assert(fcmp(BinaryAngle::radians(deg).rad(), Angle::radians(deg).rad(), 6));
+        assert(fcmp(BinaryAngle(Angle::degrees(deg)).angle(), Angle::degrees(deg), 6));
+    }
+
+    // Table-driven sine and cosine are exact on the axes, and near libm elsewhere.
+    assert(q.sin() == 1 && q.cos() == 0);
+    assert((q * 2).sin() == 0 && (q * 2).cos() == -1);
+    assert((q * 3).sin() == -1 && (q * 3).cos() == 0);
+    assert(BinaryAngle().sin() == 0 && BinaryAngle().cos() == 1);
+    for (U steps = 0, i = 0; i < 100000; ++i, steps += static_cast<U>(0x9e3779b97f4a7c15)) {
+        auto b = BinaryAngle::with_steps(steps);
+        assert(std::fabs(b.sin() - std::sin(b.rad())) < 1e-15);
+        assert(std::fabs(b.cos() - std::cos(b.rad())) < 1e-15);
+    }
+    auto last = BinaryAngle::with_steps(static_cast<U>(-1));
+    assert(std::fabs(last.sin() - std::sin(last.rad())) < 1e-15);
+    assert(std::fabs(last.cos() - std::cos(last.rad())) < 1e-15);
+
+    // A million headings accumulate without drift.
+    auto delta = BinaryAngle::degrees(360. / 1024);
+    auto heading = BinaryAngle();
+    for (auto i = 0; i < 1024 * 1000; ++i) {
+        heading += delta;
+    }
+    assert(heading == BinaryAngle());
+    assert(delta * (1024 * 1000 + 256) == q);
+}
+
+} // namespace
+
+int main()
+{
+    test<std::uint32_t>();
+    test<std::uint64_t>();
+
+    // Radians round to within a 32-bit step of the exact angle; 64-bit steps resolve the error in M_PI_2.
+    assert(BinaryAngle32::radians(M_PI_2) == BinaryAngle32::degrees(90));
+    assert(BinaryAngle32(Angle::degrees(90)) == BinaryAngle32::degrees(90));
+    assert(BinaryAngle64::radians(M_PI_2) != BinaryAngle64::degrees(90));
+
+    // Degrees of every 32-bit angle are exact.
+    assert(BinaryAngle32::with_steps(1).deg() == 360. / 4294967296.);
+    assert(BinaryAngle32::degrees(1).deg() == 11930465 * (360. / 4294967296.));
+    assert(BinaryAngle64::degrees(1).steps() == 51240955760304310u);
+}
+
+#endif
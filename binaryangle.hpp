@@ -0,0 +1,213 @@
+#pragma once
+
+#include "angle.hpp"
+
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+/// Models an angle as a binary fraction of a turn (binary angular measurement), in unsigned integer type @c U.
+/// @see https://en.wikipedia.org/wiki/Binary_angular_measurement
+/// @discussion The range of @c U spans exactly one turn, so wraparound is integer overflow: sums and differences
+/// are exact and branch-free, and accumulated headings never drift. One step is 2π/2^32 radians for
+/// @c BinaryAngle32, and 2π/2^64 for @c BinaryAngle64. Every power-of-two fraction of a turn (90°, 45°, 22.5°, …)
+/// is exact, and so are the degrees of every 32-bit angle.
+/// Sine and cosine are table-driven, indexed by the leading bits.
+/// Instantiated for @c std::uint32_t and @c std::uint64_t.
+/// @see BinaryAngle32
+/// @see BinaryAngle64
+template <typename U>
+class BasicBinaryAngle
+{
+    static_assert(std::is_unsigned_v<U>, "BasicBinaryAngle requires an unsigned integer type");
+
+public:
+    /// Number of steps in one turn, 2^digits.
+    static constexpr long double TURN = static_cast<long double>(std::numeric_limits<U>::max()) + 1;
+
+    /// Construct an empty angle (zero radians).
+    constexpr BasicBinaryAngle();
+
+    /// Construct angle nearest @c angle.
+    explicit BasicBinaryAngle(const Angle & angle);
+
+    /// Construct angle of @c steps steps of one turn / 2^digits.
+    static constexpr BasicBinaryAngle with_steps(U steps);
+
+    /// Construct angle nearest @c rad radians.
+    /// @discussion Whole turns are removed as by @c Angle::radians. Non-finite input yields zero.
+    static BasicBinaryAngle radians(double rad);
+
+    /// Construct angle nearest @c deg degrees.
+    /// @discussion Whole turns are removed exactly in degrees. Non-finite input yields zero.
+    static BasicBinaryAngle degrees(double deg);
+
+    /// @return U Steps of one turn / 2^digits.
+    constexpr U steps() const;
+
+    /// @return double Radians, in the range 0..2π.
+    constexpr double rad() const;
+
+    /// @return double Degrees, in the range 0..360.
+    constexpr double deg() const;
+
+    /// @return Angle Angle of the same radians.
+    constexpr Angle angle() const;
+
+    /// @return double Sine, from a table of 4096 entries per turn.
+    double sin() const;
+
+    /// @return double Cosine, from a table of 4096 entries per turn.
+    double cos() const;
+
+    constexpr BasicBinaryAngle & operator+=(const BasicBinaryAngle & other);
+
+    constexpr BasicBinaryAngle & operator-=(const BasicBinaryAngle & other);
+
+    constexpr BasicBinaryAngle & operator*=(U factor);
+
+    constexpr BasicBinaryAngle & operator/=(U denominator);
+
+    constexpr BasicBinaryAngle operator+(const BasicBinaryAngle & other) const;
+
+    constexpr BasicBinaryAngle operator-(const BasicBinaryAngle & other) const;
+
+    constexpr BasicBinaryAngle operator-() const;
+
+    constexpr BasicBinaryAngle operator*(U factor) const;
+
+    constexpr BasicBinaryAngle operator/(U denominator) const;
+
+    constexpr bool operator==(const BasicBinaryAngle & other) const;
+
+    constexpr bool operator!=(const BasicBinaryAngle & other) const;
+
+private:
+    /// Private constructor.
+    /// @see BasicBinaryAngle::with_steps
+    constexpr explicit BasicBinaryAngle(U steps);
+
+    /// Floating point type holding every step exactly.
+    using Wide = std::conditional_t<(std::numeric_limits<U>::digits > std::numeric_limits<double>::digits), long double, double>;
+
+    /// @return BasicBinaryAngle Angle nearest @c x steps, for |x| ≤ one turn.
+    static BasicBinaryAngle nearest(Wide x);
+
+    U steps_;
+};
+
+/// Binary angle in 32 bits, with a step of about 1.5e-9 radians.
+using BinaryAngle32 = BasicBinaryAngle<std::uint32_t>;
+
+/// Binary angle in 64 bits, with a step of about 3.4e-19 radians.
+using BinaryAngle64 = BasicBinaryAngle<std::uint64_t>;
+
+template <typename U>
+constexpr BasicBinaryAngle<U>::BasicBinaryAngle() : steps_{}
+{
+}
+
+template <typename U>
+constexpr BasicBinaryAngle<U>::BasicBinaryAngle(U steps) : steps_{steps}
+{
+}
+
+template <typename U>
+constexpr BasicBinaryAngle<U> BasicBinaryAngle<U>::with_steps(U steps)
+{
+    return BasicBinaryAngle(steps);
+}
+
+template <typename U>
+constexpr U BasicBinaryAngle<U>::steps() const
+{
+    return steps_;
+}
+
+template <typename U>
+constexpr double BasicBinaryAngle<U>::rad() const
+{
+    return static_cast<double>(steps_ * (TWOPI<long double> / TURN));
+}
+
+template <typename U>
+constexpr double BasicBinaryAngle<U>::deg() const
+{
+    return static_cast<double>(steps_ * (360 / TURN));
+}
+
+template <typename U>
+constexpr Angle BasicBinaryAngle<U>::angle() const
+{
+    return Angle::radians(rad());
+}
+
+template <typename U>
+constexpr BasicBinaryAngle<U> & BasicBinaryAngle<U>::operator+=(const BasicBinaryAngle & other)
+{
+    steps_ += other.steps_;
+    return *this;
+}
+
+template <typename U>
+constexpr BasicBinaryAngle<U> & BasicBinaryAngle<U>::operator-=(const BasicBinaryAngle & other)
+{
+    steps_ -= other.steps_;
+    return *this;
+}
+
+template <typename U>
+constexpr BasicBinaryAngle<U> & BasicBinaryAngle<U>::operator*=(U factor)
+{
+    steps_ *= factor;
+    return *this;
+}
+
+template <typename U>
+constexpr BasicBinaryAngle<U> & BasicBinaryAngle<U>::operator/=(U denominator)
+{
+    steps_ /= denominator;
+    return *this;
+}
+
+template <typename U>
+constexpr BasicBinaryAngle<U> BasicBinaryAngle<U>::operator+(const BasicBinaryAngle & other) const
+{
+    return BasicBinaryAngle(static_cast<U>(steps_ + other.steps_));
+}
+
+template <typename U>
+constexpr BasicBinaryAngle<U> BasicBinaryAngle<U>::operator-(const BasicBinaryAngle & other) const
+{
+    return BasicBinaryAngle(static_cast<U>(steps_ - other.steps_));
+}
+
+template <typename U>
+constexpr BasicBinaryAngle<U> BasicBinaryAngle<U>::operator-() const
+{
+    return BasicBinaryAngle(static_cast<U>(-steps_));
+}
+
+template <typename U>
+constexpr BasicBinaryAngle<U> BasicBinaryAngle<U>::operator*(U factor) const
+{
+    return BasicBinaryAngle(static_cast<U>(steps_ * factor));
+}
+
+template <typename U>
+constexpr BasicBinaryAngle<U> BasicBinaryAngle<U>::operator/(U denominator) const
+{
+    return BasicBinaryAngle(static_cast<U>(steps_ / denominator));
+}
+
+template <typename U>
+constexpr bool BasicBinaryAngle<U>::operator==(const BasicBinaryAngle & other) const
+{
+    return steps_ == other.steps_;
+}
+
+template <typename U>
+constexpr bool BasicBinaryAngle<U>::operator!=(const BasicBinaryAngle & other) const
+{
+    return steps_ != other.steps_;
+}
@@ -0,0 +1,395 @@
+#include "dataset.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace
+{
+
+constexpr char MAGIC[8] = {'T', 'R', 'I', 'G', 'D', 'A', 'T', 'A'};
+
+/// Alignment of columns in the file.
+constexpr std::uint64_t ALIGNMENT = 64;
+
+struct Header
+{
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t columns;
+};
+
+struct Entry
+{
+    std::uint32_t column;
+    std::uint32_t reserved;
+    std::uint64_t rows;
+    std::uint64_t offset;
+};
+
+static_assert(sizeof(Header) == 16 && sizeof(Entry) == 24, "Header and Entry must be packed");
+static_assert(__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__, "Datasets are read and written in place, so little-endian");
+
+/// @return std::size_t Index of column @c c.
+inline std::size_t index(Column c)
+{
+    return static_cast<std::size_t>(c) - 1;
+}
+
+/// Indices of the first and last columns of a group, read together.
+struct Group
+{
+    std::size_t first;
+    std::size_t last;
+};
+
+/// Columns of points, vectors and triangles.
+const Group GROUPS[] = {
+    {index(Column::PointX), index(Column::PointY)},
+    {index(Column::TailX), index(Column::HeadY)},
+    {index(Column::SideA), index(Column::AngleC)},
+};
+
+} // namespace
+
+DatasetWriter::DatasetWriter() : spools_{}, rows_{}
+{
+    for (auto & spool : spools_) {
+        spool = std::tmpfile();
+    }
+}
+
+DatasetWriter::~DatasetWriter()
+{
+    for (auto spool : spools_) {
+        if (spool) {
+            std::fclose(spool);
+        }
+    }
+}
+
+void DatasetWriter::append(Column c, double x)
+{
+    // Write errors are sticky, so are found by write.
+    if (auto spool = spools_[index(c)]) {
+        std::fwrite(&x, sizeof x, 1, spool);
+    }
+    ++rows_[index(c)];
+}
+
+void DatasetWriter::add(const Point & point)
+{
+    append(Column::PointX, point.x());
+    append(Column::PointY, point.y());
+}
+
+void DatasetWriter::add(const Vector & vector)
+{
+    append(Column::TailX, vector.tail().x());
+    append(Column::TailY, vector.tail().y());
+    append(Column::HeadX, vector.head().x());
+    append(Column::HeadY, vector.head().y());
+}
+
+void DatasetWriter::add(const Triangle & triangle)
+{
+    append(Column::SideA, triangle.a());
+    append(Column::SideB, triangle.b());
+    append(Column::SideC, triangle.c());
+    append(Column::AngleA, triangle.A().rad());
+    append(Column::AngleB, triangle.B().rad());
+    append(Column::AngleC, triangle.C().rad());
+}
+
+bool DatasetWriter::write(const std::string & path) const
+{
+    auto spooled = true;
+    for (auto spool : spools_) {
+        spooled = spooled && spool && std::fflush(spool) == 0 && !std::ferror(spool);
+    }
+
+    Header header;
+    std::memcpy(header.magic, MAGIC, sizeof MAGIC);
+    header.version = VERSION;
+    header.columns = COLUMNS;
+
+    Entry entries[COLUMNS];
+    auto offset = static_cast<std::uint64_t>(sizeof header + sizeof entries);
+    for (std::size_t i = 0; i < COLUMNS; ++i) {
+        offset = (offset + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT;
+        entries[i] = {static_cast<std::uint32_t>(i + 1), 0, rows_[i], offset};
+        offset += rows_[i] * sizeof(double);
+    }
+
+    auto file = spooled ? std::fopen(path.c_str(), "wb") : nullptr;
+    if (!file) {
+        return false;
+    }
+
+    auto ok = std::fwrite(&header, sizeof header, 1, file) == 1
+        && std::fwrite(entries, sizeof entries, 1, file) == 1;
+
+    // Copy each spool in chunks, reading by position so later rows are still appended at the end.
+    static const char padding[ALIGNMENT] = {};
+    char buffer[1 << 16];
+    auto position = static_cast<std::uint64_t>(sizeof header + sizeof entries);
+    for (std::size_t i = 0; ok && i < COLUMNS; ++i) {
+        auto pad = entries[i].offset - position;
+        ok = pad == 0 || std::fwrite(padding, pad, 1, file) == 1;
+        auto size = rows_[i] * sizeof(double);
+        for (std::uint64_t done = 0; ok && done < size;) {
+            auto n = pread(fileno(spools_[i]), buffer, std::min<std::uint64_t>(sizeof buffer, size - done),
+                           static_cast<off_t>(done));
+            ok = n > 0 && std::fwrite(buffer, 1, n, file) == static_cast<std::size_t>(n);
+            done += ok ? n : 0;
+        }
+        position = entries[i].offset + size;
+    }
+
+    return std::fclose(file) == 0 && ok;
+}
+
+Dataset::Dataset() : data_{nullptr}, length_{0}, columns_{}, sizes_{}
+{
+}
+
+Dataset::~Dataset()
+{
+    close();
+}
+
+bool Dataset::open(const std::string & path)
+{
+    close();
+
+    auto fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+
+    struct stat st;
+    auto length = fstat(fd, &st) == 0 ? static_cast<std::size_t>(st.st_size) : 0;
+    auto data = length >= sizeof(Header) ? mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0) : MAP_FAILED;
+    ::close(fd);
+    if (data == MAP_FAILED) {
+        return false;
+    }
+
+    data_ = data;
+    length_ = length;
+
+    auto bytes = static_cast<const unsigned char *>(data);
+    Header header;
+    std::memcpy(&header, bytes, sizeof header);
+    if (std::memcmp(header.magic, MAGIC, sizeof MAGIC) != 0
+        || header.version != DatasetWriter::VERSION
+        || header.columns > (length - sizeof header) / sizeof(Entry)) {
+        close();
+        return false;
+    }
+
+    for (std::uint32_t i = 0; i < header.columns; ++i) {
+        Entry entry;
+        std::memcpy(&entry, bytes + sizeof header + i * sizeof entry, sizeof entry);
+
+        // Columns beyond those known (from a later writer) are ignored.
+        if (entry.column == 0 || entry.column > COLUMNS) {
+            continue;
+        }
+
+        if (entry.offset % sizeof(double) != 0
+            || entry.offset > length
+            || entry.rows > (length - entry.offset) / sizeof(double)) {
+            close();
+            return false;
+        }
+
+        auto c = entry.column - 1;
+        sizes_[c] = entry.rows;
+        columns_[c] = entry.rows ? reinterpret_cast<const double *>(bytes + entry.offset) : nullptr;
+    }
+
+    // Each point, vector and triangle spans a group of columns, so they must have equal rows.
+    for (auto & group : GROUPS) {
+        for (auto c = group.first; c <= group.last; ++c) {
+            if (sizes_[c] != sizes_[group.first]) {
+                close();
+                return false;
+            }
+        }
+    }
+
+    // Columns are read front to back.
+    madvise(data_, length_, MADV_SEQUENTIAL);
+    return true;
+}
+
+void Dataset::close()
+{
+    if (data_) {
+        munmap(data_, length_);
+    }
+
+    data_ = nullptr;
+    length_ = 0;
+    for (std::size_t i = 0; i < COLUMNS; ++i) {
+        columns_[i] = nullptr;
+        sizes_[i] = 0;
+    }
+}
+
+const double * Dataset::column(Column c) const
+{
+    return columns_[index(c)];
+}
+
+std::size_t Dataset::size(Column c) const
+{
+    return sizes_[index(c)];
+}
+
+std::size_t Dataset::points() const
+{
+    return size(Column::PointX);
+}
+
+std::size_t Dataset::vectors() const
+{
+    return size(Column::TailX);
+}
+
+std::size_t Dataset::triangles() const
+{
+    return size(Column::SideA);
+}
+
+Point Dataset::point(std::size_t i) const
+{
+    return Point(column(Column::PointX)[i], column(Column::PointY)[i]);
+}
+
+Vector Dataset::vector(std::size_t i) const
+{
+    return Vector(Point(column(Column::TailX)[i], column(Column::TailY)[i]),
+                  Point(column(Column::HeadX)[i], column(Column::HeadY)[i]));
+}
+
+Triangle Dataset::triangle(std::size_t i) const
+{
+    return Triangle(column(Column::SideA)[i], column(Column::SideB)[i], column(Column::SideC)[i],
+                    Angle::radians(column(Column::AngleA)[i]),
+                    Angle::radians(column(Column::AngleB)[i]),
+                    Angle::radians(column(Column::AngleC)[i]));
+}
+
+#ifdef UNITTEST_DATASET
+
+#include <cassert>
+
+int main()
+{
+    const std::string path = "dataset.test";
+
+    DatasetWriter writer;
+    for (auto i = 0; i < 1001; ++i) {
+        writer.add(Point(i, -i * 0.5));
+    }
+    writer.add(Vector(Point(1, 2), Point(4, 6)));
+    writer.add(Vector(Point(3, 4)));
+    writer.add(Triangle(3, 4, 5));
+    assert(writer.write(path));
+
+    Dataset d;
+    assert(d.open(path));
+    assert(d.points() == 1001 && d.vectors() == 2 && d.triangles() == 1);
+    assert(d.size(Column::PointY) == 1001 && d.size(Column::AngleC) == 1);
+
+    // Columns are aligned, and read in place.
+    assert(reinterpret_cast<std::uintptr_t>(d.column(Column::PointX)) % ALIGNMENT == 0);
+    assert(d.column(Column::PointX)[1000] == 1000 && d.column(Column::PointY)[1000] == -500);
+    assert(d.point(7).x() == 7 && d.point(7).y() == -3.5);
+
+    assert(d.vector(0).tail().x() == 1 && d.vector(0).head().y() == 6);
+    assert(d.vector(1).description() == Vector(Point(3, 4)).description());
+
+    assert(d.triangle(0).description() == Triangle(3, 4, 5).description());
+    assert(d.column(Column::AngleC)[0] == Triangle(3, 4, 5).C().rad());
+
+    // Triangles are read with their stored angles, not solved again.
+    {
+        auto t = Triangle::with_A_B_c(Angle::degrees(30), Angle::degrees(40), 50);
+        DatasetWriter w;
+        w.add(t);
+        assert(w.write(path + ".angles"));
+        Dataset e;
+        assert(e.open(path + ".angles"));
+        auto u = e.triangle(0);
+        assert(u.A() == t.A() && u.B() == t.B() && u.C() == t.C());
+        assert(u.a() == t.a() && u.b() == t.b() && u.c() == t.c());
+        std::remove((path + ".angles").c_str());
+    }
+
+    // Columns larger than the copy buffer are written whole, and rows added after a write are written next time.
+    {
+        DatasetWriter w;
+        for (auto i = 0; i < 20000; ++i) {
+            w.add(Point(i, i));
+        }
+        assert(w.write(path + ".large"));
+        w.add(Point(-1, -2));
+        assert(w.write(path + ".large"));
+        Dataset e;
+        assert(e.open(path + ".large"));
+        assert(e.points() == 20001);
+        assert(e.point(8192).x() == 8192 && e.point(19999).y() == 19999);
+        assert(e.point(20000).x() == -1 && e.point(20000).y() == -2);
+        std::remove((path + ".large").c_str());
+    }
+
+    // Reopening replaces the mapping.
+    assert(d.open(path));
+    assert(d.points() == 1001);
+
+    // Malformed files are refused.
+    auto corrupt = [&](long offset, const char * bytes, std::size_t size) {
+        writer.write(path);
+        auto file = std::fopen(path.c_str(), "r+b");
+        std::fseek(file, offset, SEEK_SET);
+        std::fwrite(bytes, size, 1, file);
+        std::fclose(file);
+        return d.open(path);
+    };
+    assert(!corrupt(0, "X", 1));
+    assert(!corrupt(8, "\x02", 1));
+    assert(!corrupt(13, "\xff", 1));
+    assert(!corrupt(16 + 16, "\x01", 1));
+    assert(!corrupt(16 + 8, "\xff\xff\xff", 3));
+
+    // Columns of a group with unequal rows: PointY and AngleC with none.
+    assert(!corrupt(16 + 24 + 8, "\x00\x00", 2));
+    assert(!corrupt(16 + 11 * 24 + 8, "\x00", 1));
+
+    // Unknown columns are ignored: here both point columns, so there are no points.
+    const char unknown[28] = {};
+    assert(corrupt(16, unknown, sizeof unknown));
+    assert(d.points() == 0 && d.column(Column::PointX) == nullptr && d.column(Column::PointY) == nullptr);
+
+    d.close();
+    assert(d.points() == 0);
+
+    // Empty, truncated and missing files are refused.
+    assert(DatasetWriter().write(path));
+    assert(d.open(path));
+    assert(d.points() == 0 && d.triangles() == 0);
+    std::fclose(std::fopen(path.c_str(), "wb"));
+    assert(!d.open(path));
+    std::remove(path.c_str());
+    assert(!d.open(path));
+    assert(!DatasetWriter().write("no/such/directory/dataset"));
+}
+
+#endif
@@ -0,0 +1,128 @@
+#pragma once
+
+#include "point.hpp"
+#include "triangle.hpp"
+#include "vector.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+
+/// Columns of a dataset, each an array of doubles.
+enum class Column : std::uint32_t
+{
+    PointX = 1,
+    PointY,
+    TailX,
+    TailY,
+    HeadX,
+    HeadY,
+    SideA,
+    SideB,
+    SideC,
+    AngleA,
+    AngleB,
+    AngleC,
+};
+
+/// Number of columns in a dataset.
+constexpr std::size_t COLUMNS = 12;
+
+/// Collects points, vectors and triangles, and writes them as a dataset file.
+/// @discussion The file is little-endian and columnar:
+/// ```
+/// offset 0   "TRIGDATA", version (u32), column count (u32)
+/// offset 16  column count × { column (u32), reserved (u32), rows (u64), offset (u64) }
+///            columns of doubles, each at an offset aligned to 64 bytes
+/// ```
+/// Triangles are stored with their angles, so readers need no trigonometry.
+/// Each column is spooled to its own temporary file (@c std::tmpfile) as rows are added, and the spools are
+/// concatenated on @c write, so memory use does not grow with the dataset; the temporary directory needs space
+/// for it instead.
+class DatasetWriter
+{
+public:
+    /// Format version written.
+    static constexpr std::uint32_t VERSION = 1;
+
+    /// Construct an empty writer.
+    DatasetWriter();
+
+    DatasetWriter(const DatasetWriter &) = delete;
+    DatasetWriter & operator=(const DatasetWriter &) = delete;
+
+    ~DatasetWriter();
+
+    /// Append @c point.
+    void add(const Point & point);
+
+    /// Append @c vector.
+    void add(const Vector & vector);
+
+    /// Append @c triangle.
+    void add(const Triangle & triangle);
+
+    /// Write the dataset to the file at @c path. Rows may be added after, and written again.
+    /// @return bool Whether the file was written: false also if a temporary file could not be created or written.
+    bool write(const std::string & path) const;
+
+private:
+    void append(Column c, double x);
+
+    std::FILE * spools_[COLUMNS];
+    std::uint64_t rows_[COLUMNS];
+};
+
+/// Reads a dataset file, by mapping it into memory.
+/// @discussion Opening validates only the header and directory, so is O(1) in the size of the file; columns
+/// are exposed in place, without copying, and paged in as they are read.
+class Dataset
+{
+public:
+    /// Construct a closed dataset.
+    Dataset();
+
+    Dataset(const Dataset &) = delete;
+    Dataset & operator=(const Dataset &) = delete;
+
+    ~Dataset();
+
+    /// Map the dataset file at @c path (closing any already open).
+    /// @return bool Whether the file was opened: false if unreadable, malformed (including a point, vector or
+    /// triangle whose columns have unequal rows), or of another version.
+    bool open(const std::string & path);
+
+    /// Unmap the file.
+    void close();
+
+    /// @return const double * Column @c c, or null if empty.
+    const double * column(Column c) const;
+
+    /// @return std::size_t Rows in column @c c.
+    std::size_t size(Column c) const;
+
+    /// @return std::size_t Number of points.
+    std::size_t points() const;
+
+    /// @return std::size_t Number of vectors.
+    std::size_t vectors() const;
+
+    /// @return std::size_t Number of triangles.
+    std::size_t triangles() const;
+
+    /// @return Point The point at @c index.
+    Point point(std::size_t index) const;
+
+    /// @return Vector The vector at @c index.
+    Vector vector(std::size_t index) const;
+
+    /// @return Triangle The triangle at @c index.
+    Triangle triangle(std::size_t index) const;
+
+private:
+    void * data_;
+    std::size_t length_;
+    const double * columns_[COLUMNS];
+    std::size_t sizes_[COLUMNS];
+};
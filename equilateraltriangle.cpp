@@ -1,59 +1,65 @@
 #include "equilateraltriangle.hpp"
 
-#include <cmath>
-#include <sstream>
-
-EquilateralTriangle::EquilateralTriangle(double side) : side_{side}
-{
-}
-
-Angle EquilateralTriangle::angle() const
-{
-    return Angle::degrees(60);
-}
+#include "format.hpp"
 
-double EquilateralTriangle::side() const
-{
-    return side_;
-}
+#include <cmath>
 
-double EquilateralTriangle::height() const
+template <typename T>
+std::string BasicEquilateralTriangle<T>::description() const
 {
-    // Given Pythagoras theorem: Hypotenuse² = Base² + Height²
-    // Then a² = (a/2)² + h²
-    // Then h² = a² - (a/2)²
-    // Then h² = (3a²)/4
-    // Or   h  = (a√3)/2
-    return side_ * sqrt(3) / 2;
+    return describe(*this);
 }
 
-std::string EquilateralTriangle::description() const
+template <typename T>
+std::size_t BasicEquilateralTriangle<T>::format_to(char * buffer, std::size_t size) const
 {
-    std::stringstream ss;
-    ss << "EquilateralTriangle "
+    return (Format(buffer, size) << "EquilateralTriangle "
         << side() << "; "
-        << angle() << " (" << angle().deg() << "°)";
-    return ss.str();
+        << angle() << " (" << angle().deg() << "°)").size();
 }
 
+template class BasicEquilateralTriangle<float>;
+template class BasicEquilateralTriangle<double>;
+template class BasicEquilateralTriangle<long double>;
+
 #ifdef UNITTEST_EQUILATERALTRIANGLE
 
 #include "fcmp.hpp"
 #include "rightangledtriangle.hpp"
 
 #include <cassert>
+#include <limits>
 
-int main()
+namespace
 {
-    auto t = EquilateralTriangle(8);
-    assert(fcmp(t.angle(), Angle::degrees(60)));
-    assert(fcmp(t.side(), 8.00));
-    assert(fcmp(t.height(), 6.928));
 
-    auto r = RightAngledTriangle::with_A_c(t.angle() / 2., t.side());
+/// Check equilateral triangles in precision @c T.
+template <typename T>
+void test()
+{
+    using Angle = BasicAngle<T>;
+    using EquilateralTriangle = BasicEquilateralTriangle<T>;
+    using RightAngledTriangle = BasicRightAngledTriangle<T>;
+
+    constexpr auto t = EquilateralTriangle(8);
+    static_assert(t.angle() == Angle::degrees(60));
+    static_assert(t.side() == 8);
+    static_assert(t.height() > T(6.928) && t.height() < T(6.929));
+    assert(fcmp(t.height(), 8 * std::sqrt(T(3)) / 2, std::numeric_limits<T>::digits10 - 2));
+
+    auto r = RightAngledTriangle::with_A_c(t.angle() / T(2), t.side());
     assert(fcmp(t.height(), r.b()));
 
     assert(t.description() == "EquilateralTriangle 8; 1.0472 (60°)");
 }
 
+} // namespace
+
+int main()
+{
+    test<float>();
+    test<double>();
+    test<long double>();
+}
+
 #endif
@@ -2,6 +2,7 @@
 
 #include "angle.hpp"
 
+#include <cstddef>
 #include <string>
 
 /// Models an equilateral triangle.
@@ -14,24 +15,67 @@
 ///   +---------+
 ///       side
 /// ```
-class EquilateralTriangle
+/// Instantiated for @c float, @c double and @c long double.
+/// @see EquilateralTriangle
+template <typename T>
+class BasicEquilateralTriangle
 {
 public:
+    using Angle = BasicAngle<T>;
+
     /// Construct equilateral triangle with side length @c side.
-    EquilateralTriangle(double side);
+    constexpr BasicEquilateralTriangle(T side);
 
     /// @return double Internal angle.
-    Angle angle() const;
+    constexpr Angle angle() const;
 
-    /// @return double Length of side.
-    double side() const;
+    /// @return T Length of side.
+    constexpr T side() const;
 
-    /// @return double Computed height.
-    double height() const;
+    /// @return T Computed height.
+    constexpr T height() const;
 
     /// @return std::string Description.
     std::string description() const;
 
+    /// Format description into @c buffer of @c size characters, without allocating.
+    /// @discussion Writes at most @c size characters, without a terminator; the output matches @c description.
+    /// @see format_to(const T &, OutputIt) to format to an output iterator.
+    /// @return std::size_t Length of the whole description.
+    std::size_t format_to(char * buffer, std::size_t size) const;
+
 private:
-    double side_;
+    T side_;
 };
+
+/// Equilateral triangle in double precision.
+using EquilateralTriangle = BasicEquilateralTriangle<double>;
+
+template <typename T>
+constexpr BasicEquilateralTriangle<T>::BasicEquilateralTriangle(T side) : side_{side}
+{
+}
+
+template <typename T>
+constexpr BasicAngle<T> BasicEquilateralTriangle<T>::angle() const
+{
+    return Angle::degrees(60);
+}
+
+template <typename T>
+constexpr T BasicEquilateralTriangle<T>::side() const
+{
+    return side_;
+}
+
+template <typename T>
+constexpr T BasicEquilateralTriangle<T>::height() const
+{
+    // Given Pythagoras theorem: Hypotenuse² = Base² + Height²
+    // Then a² = (a/2)² + h²
+    // Then h² = a² - (a/2)²
+    // Then h² = (3a²)/4
+    // Or   h  = (a√3)/2
+    constexpr auto SQRT3_2 = static_cast<T>(0.866025403784438646763723170752936183L);
+    return side_ * SQRT3_2;
+}
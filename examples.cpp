@@ -1,13 +1,18 @@
 #include "fcmp.hpp"
+#include "binaryangle.hpp"
 #include "equilateraltriangle.hpp"
 #include "isoscelestriangle.hpp"
+#include "path.hpp"
 #include "rightangledtriangle.hpp"
+#include "transform.hpp"
 #include "triangle.hpp"
+#include "unitangle.hpp"
 #include "vector.hpp"
 
 #include <cassert>
 #include <cmath>
 #include <cstdio>
+#include <vector>
 
 int main()
 {
@@ -158,4 +163,73 @@ int main()
         auto BCD_D = Angle::degrees(180) - ABC.baseAngle() - BCD_B;
         assert(fcmp(BCD_D, Angle::degrees(30)));
     }
+
+    {
+        // Types are templates on their floating point precision.
+
+        auto t = BasicRightAngledTriangle<float>::with_a_b(3, 4);
+
+        assert(fcmp(t.A(), BasicAngle<float>::degrees(36.87)));
+        assert(fcmp(TWOPI<long double>, M_TWOPI));
+    }
+
+    {
+        // Binary angles wrap around by integer overflow.
+
+        auto heading = BinaryAngle32();
+        for (auto i = 0; i < 1024 * 1000; ++i) {
+            heading += BinaryAngle32::degrees(360. / 1024);
+        }
+
+        assert(heading == BinaryAngle32());
+        assert(BinaryAngle32::degrees(90).cos() == 0);
+        assert(fcmp(BinaryAngle32(Angle::degrees(30)).sin(), 0.5));
+    }
+
+    {
+        // Transforms accumulate rotations and translations into one matrix.
+
+        auto u = Vector(Point(3, 4));
+        auto m = Transform().rotate(u.direction()).translate(u.head());
+        auto v = m.apply(Vector(Angle::degrees(90), 5));
+
+        assert(v.tail() == u.head());
+        assert(fcmp(v.magnitude(), 5));
+    }
+
+    {
+        // Paths walk turtle-style segments from a start point and heading.
+
+        auto p = Path(Point(), Angle::degrees(45));
+        for (auto i = 0; i < 4; ++i) {
+            p.add(Angle::degrees(90), 1);
+        }
+
+        assert(p.vertices().size() == 5);
+        assert(fcmp(p.closure(), 0));
+    }
+
+    {
+        // Unit angles cache their cosine and sine.
+
+        auto A = UnitAngle::degrees(36.87);
+        auto t = RightAngledTriangle::with_A_c(A, 5);
+
+        assert(t.A() == A.angle());
+        assert(fcmp(t.b(), 4, 3));
+        assert(fcmp(Vector(A + A, 5).head().x(), 1.4, 3));
+    }
+
+    {
+        // Similar triangles rescale a known triangle without trigonometry.
+
+        auto r = RightAngledTriangle::with_a_b(3, 4);
+        std::vector<double> c = {0.5, 5, 50};
+        std::vector<RightAngledTriangle> family(c.size(), r);
+        RightAngledTriangle::similar_c(r, c.data(), c.size(), family.data());
+
+        assert(family[2].A() == r.A());
+        assert(fcmp(family[2].b(), 40));
+        assert(RightAngledTriangle::scaled(r, 2).A() == r.A());
+    }
 }
@@ -1,16 +1,98 @@
 #include "fcmp.hpp"
 
+#include "simd.hpp"
+
+#include <algorithm>
 #include <cmath>
 
+namespace
+{
+
+/// Powers of ten, exactly, for precisions 0..22.
+constexpr double SCALES[] = {
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22,
+};
+
+/// @return double 10^precision, as @c pow(10, precision).
+inline double scale(int precision)
+{
+    return precision >= 0 && precision <= 22 ? SCALES[precision] : pow(10, precision);
+}
+
+/// Compare @c size pairs @c x[i] and @c y[i] with @c equal, into @c mask.
+template <typename F>
+void compare(const double * x, const double * y, std::size_t size, std::uint64_t * mask, F equal)
+{
+    std::fill(mask, mask + (size + 63) / 64, 0);
+
+    // Packs are 1, 2 or 4 wide, so never straddle a word.
+    simd::for_each(size, [&](std::size_t i, auto t) {
+        using T = decltype(t);
+        auto m = equal(simd::load<T>(x + i), simd::load<T>(y + i));
+        mask[i / 64] |= static_cast<std::uint64_t>(simd::bits(m)) << (i % 64);
+    });
+}
+
+} // namespace
+
 bool fcmp(double x, double y, int precision)
 {
-    auto scale = pow(10, precision);
-    return round(x * scale) == round(y * scale);
+    auto s = scale(precision);
+    return round(x * s) == round(y * s);
+}
+
+void fcmp(const double * x, const double * y, std::size_t size, std::uint64_t * mask, int precision)
+{
+    auto s = scale(precision);
+    compare(x, y, size, mask, [s](auto x, auto y) {
+        return simd::round(x * s) == simd::round(y * s);
+    });
+}
+
+void Absolute::operator()(const double * x, const double * y, std::size_t size, std::uint64_t * mask) const
+{
+    auto e = epsilon;
+    compare(x, y, size, mask, [e](auto x, auto y) {
+        return (x == y) | (simd::abs(x - y) <= e);
+    });
+}
+
+void Relative::operator()(const double * x, const double * y, std::size_t size, std::uint64_t * mask) const
+{
+    auto e = epsilon;
+    compare(x, y, size, mask, [e](auto x, auto y) {
+        auto ax = simd::abs(x);
+        auto ay = simd::abs(y);
+        return (x == y) | (simd::abs(x - y) <= e * simd::select(ax > ay, ax, ay));
+    });
+}
+
+void Ulp::operator()(const double * x, const double * y, std::size_t size, std::uint64_t * mask) const
+{
+    // Integer lanes are not in simd.hpp; this loop is left to the compiler to vectorise.
+    std::fill(mask, mask + (size + 63) / 64, 0);
+    for (std::size_t i = 0; i < size; ++i) {
+        mask[i / 64] |= static_cast<std::uint64_t>((*this)(x[i], y[i])) << (i % 64);
+    }
 }
 
 #ifdef UNITTEST_FCMP
 
 #include <cassert>
+#include <limits>
+#include <vector>
+
+namespace
+{
+
+/// @return bool Whether bit @c i of @c mask is set.
+bool test(const std::vector<std::uint64_t> & mask, std::size_t i)
+{
+    return (mask[i / 64] >> (i % 64)) & 1;
+}
+
+} // namespace
 
 int main()
 {
@@ -29,6 +111,67 @@ int main()
     assert(!fcmp(3.1415926535, 3.14159264, 8));
     assert( fcmp(3.1415926535, 3.14159265, 8));
     assert(!fcmp(3.1415926535, 3.14159266, 8));
+
+    // Precision outside the table.
+    assert( fcmp(1234, 1000, -3));
+    assert(!fcmp(1e-23, 2e-23, 23));
+
+    // Compile-time precision.
+    static_assert(Decimal<3>::SCALE == 1e3 && Decimal<22>::SCALE == 1e22);
+    assert( fcmp<4>(3.9999946407, 4));
+    assert(!fcmp<8>(3.1415926535, 3.14159266));
+
+    // Absolute and relative tolerances.
+    assert( Absolute{0.5}(1., 1.5));
+    assert(!Absolute{0.5}(1., 1.6));
+    assert( Relative{1e-3}(1000., 1001.));
+    assert(!Relative{1e-3}(1., 1.002));
+
+    // ULP distance.
+    assert( Ulp{0}(0., -0.));
+    assert( Ulp{1}(1., std::nextafter(1., 2.)));
+    assert(!Ulp{1}(1., std::nextafter(std::nextafter(1., 2.), 2.)));
+    assert( Ulp{2}(-std::numeric_limits<double>::denorm_min(), std::numeric_limits<double>::denorm_min()));
+    assert( Ulp{1}(std::numeric_limits<double>::max(), std::numeric_limits<double>::infinity()));
+
+    // Batch comparisons agree with scalar ones, including at ties, signs and non-finite values.
+    constexpr auto inf = std::numeric_limits<double>::infinity();
+    constexpr auto nan = std::numeric_limits<double>::quiet_NaN();
+    std::vector<double> x = {0.0005, -0.0005, 0.0015, 2.5e-3, 0.49999999999999994, 1e300, -1e300, inf, -inf, nan, 0.,
+                             3.1415926535, 0x1p+51 + 0.5, -0x1p+52, 4.0004999, 1., 1000.};
+    std::vector<double> y = {0.0004, -0.0004, 0.0025, 3.5e-3, 0., 1e300, 1e300, inf, inf, nan, -0.,
+                             3.1415, 0x1p+51 + 1.5, -0x1p+52, 4.0005, std::nextafter(1., 2.), 1000.5};
+    for (std::size_t i = 0; i < 130; ++i) {
+        x.push_back(i * 0.0005);
+        y.push_back(i * 0.0005 + ((i % 3) * 0.0004));
+    }
+
+    auto size = x.size();
+    std::vector<std::uint64_t> mask((size + 63) / 64, ~0ull);
+
+    for (auto precision : {0, 3, 4, 25}) {
+        fcmp(x.data(), y.data(), size, mask.data(), precision);
+        for (std::size_t i = 0; i < size; ++i) {
+            assert(test(mask, i) == fcmp(x[i], y[i], precision));
+            assert(test(mask, i) == (round(x[i] * pow(10, precision)) == round(y[i] * pow(10, precision))));
+        }
+    }
+
+    Decimal<3>()(x.data(), y.data(), size, mask.data());
+    for (std::size_t i = 0; i < size; ++i) {
+        assert(test(mask, i) == fcmp<3>(x[i], y[i]));
+        assert(test(mask, i) == fcmp(x[i], y[i]));
+    }
+
+    auto check = [&](auto compare) {
+        compare(x.data(), y.data(), size, mask.data());
+        for (std::size_t i = 0; i < size; ++i) {
+            assert(test(mask, i) == compare(x[i], y[i]));
+        }
+    };
+    check(Absolute{1e-4});
+    check(Relative{1e-4});
+    check(Ulp{1});
 }
 
 #endif
@@ -1,5 +1,119 @@
 #pragma once
 
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
 /// Fuzzy floating point comparison.
 /// @return True if parameters are equal after rounding to @c precision decimal places.
 bool fcmp(double x, double y, int precision = 3);
+
+/// Fuzzy floating point comparison of @c size pairs @c x[i] and @c y[i], as above.
+/// @discussion Sets bit (i % 64) of @c mask[i / 64] if the pair is equal, otherwise clears it.
+void fcmp(const double * x, const double * y, std::size_t size, std::uint64_t * mask, int precision = 3);
+
+/// @return double 10^n, exactly for 0 ≤ n ≤ 22.
+constexpr double decimalScale(int n)
+{
+    return n > 0 ? 10. * decimalScale(n - 1) : 1.;
+}
+
+/// Comparators.
+/// @discussion Function objects comparing two doubles, or @c size pairs into a bitmask (as the batch @c fcmp).
+/// Batch comparisons agree exactly with scalar ones.
+
+/// Decimal comparison, to @c Precision decimal places (as @c fcmp).
+template <int Precision>
+struct Decimal
+{
+    static_assert(Precision >= 0 && Precision <= 22, "Precision must be in the range 0..22");
+
+    /// 10^Precision, exactly.
+    static constexpr double SCALE = decimalScale(Precision);
+
+    bool operator()(double x, double y) const;
+    void operator()(const double * x, const double * y, std::size_t size, std::uint64_t * mask) const;
+};
+
+/// Absolute comparison: equal if within @c epsilon.
+struct Absolute
+{
+    double epsilon;
+
+    bool operator()(double x, double y) const;
+    void operator()(const double * x, const double * y, std::size_t size, std::uint64_t * mask) const;
+};
+
+/// Relative comparison: equal if within @c epsilon of the larger magnitude.
+struct Relative
+{
+    double epsilon;
+
+    bool operator()(double x, double y) const;
+    void operator()(const double * x, const double * y, std::size_t size, std::uint64_t * mask) const;
+};
+
+/// ULP comparison: equal if at most @c ulps representable doubles apart.
+/// @discussion Zeros of either sign are 0 ulps apart; NaN equals nothing.
+struct Ulp
+{
+    std::uint64_t ulps;
+
+    bool operator()(double x, double y) const;
+    void operator()(const double * x, const double * y, std::size_t size, std::uint64_t * mask) const;
+
+    /// @return std::int64_t @c x mapped to an integer, ordered as doubles are.
+    static std::int64_t ordinal(double x);
+};
+
+/// Fuzzy floating point comparison, to @c Precision decimal places fixed at compile time.
+/// @return True if parameters are equal after rounding to @c Precision decimal places.
+template <int Precision>
+bool fcmp(double x, double y)
+{
+    return Decimal<Precision>()(x, y);
+}
+
+template <int Precision>
+bool Decimal<Precision>::operator()(double x, double y) const
+{
+    return std::round(x * SCALE) == std::round(y * SCALE);
+}
+
+template <int Precision>
+void Decimal<Precision>::operator()(const double * x, const double * y, std::size_t size, std::uint64_t * mask) const
+{
+    fcmp(x, y, size, mask, Precision);
+}
+
+inline bool Absolute::operator()(double x, double y) const
+{
+    return x == y || std::fabs(x - y) <= epsilon;
+}
+
+inline bool Relative::operator()(double x, double y) const
+{
+    return x == y || std::fabs(x - y) <= epsilon * std::fmax(std::fabs(x), std::fabs(y));
+}
+
+inline bool Ulp::operator()(double x, double y) const
+{
+    if (std::isnan(x) || std::isnan(y)) {
+        return false;
+    }
+
+    auto i = ordinal(x);
+    auto j = ordinal(y);
+    auto d = i < j ? static_cast<std::uint64_t>(j) - static_cast<std::uint64_t>(i)
+                   : static_cast<std::uint64_t>(i) - static_cast<std::uint64_t>(j);
+    return d <= ulps;
+}
+
+inline std::int64_t Ulp::ordinal(double x)
+{
+    std::int64_t i;
+    std::memcpy(&i, &x, sizeof i);
+    // Negative doubles order in reverse, from -0 (at 0).
+    return i < 0 ? INT64_MIN - i : i;
+}
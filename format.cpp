@@ -0,0 +1,143 @@
+#include "format.hpp"
+
+#include <charconv>
+#include <cstring>
+
+Format::Format(char * buffer, std::size_t size) : next_{buffer}, last_{buffer + size}, size_{0}
+{
+}
+
+Format & Format::operator<<(const char * text)
+{
+    write(text, strlen(text));
+    return *this;
+}
+
+template <typename T>
+Format & Format::number(T x)
+{
+    // Longest is "-1.18973e+4932".
+    char buffer[16];
+    auto result = std::to_chars(buffer, buffer + sizeof buffer, x, std::chars_format::general, 6);
+    write(buffer, result.ptr - buffer);
+    return *this;
+}
+
+Format & Format::operator<<(float x)
+{
+    return number(x);
+}
+
+Format & Format::operator<<(double x)
+{
+    return number(x);
+}
+
+Format & Format::operator<<(long double x)
+{
+    return number(x);
+}
+
+std::size_t Format::size() const
+{
+    return size_;
+}
+
+void Format::write(const char * text, std::size_t size)
+{
+    auto n = std::min(size, static_cast<std::size_t>(last_ - next_));
+    // Measuring with a null buffer of no size copies nothing, and memcpy must not be passed null.
+    if (n) {
+        memcpy(next_, text, n);
+        next_ += n;
+    }
+    size_ += size;
+}
+
+#ifdef UNITTEST_FORMAT
+
+#include <cassert>
+#include <cmath>
+#include <iterator>
+#include <limits>
+#include <sstream>
+#include <string>
+
+namespace
+{
+
+struct Described
+{
+    std::size_t format_to(char * buffer, std::size_t size) const
+    {
+        return (Format(buffer, size) << "Described " << 1.5).size();
+    }
+};
+
+struct Long
+{
+    std::size_t format_to(char * buffer, std::size_t size) const
+    {
+        static const auto text = std::string(DESCRIPTION_SIZE + 1, 'x') + " ";
+        return (Format(buffer, size) << text.c_str() << 1.5).size();
+    }
+};
+
+} // namespace
+
+int main()
+{
+    // Numbers format byte-identically to std::ostream.
+    auto values = {0., -0., 1., 5., 7.99999, 7.999995, 0.643503, 106.26, 1e-5, 1.23456789e-5, 123456., 1234567.,
+                   -3.14159265, 1e300, -1e-300, 5e-324, M_PI, std::numeric_limits<double>::infinity(),
+                   -std::numeric_limits<double>::infinity(), std::numeric_limits<double>::max()};
+    for (auto x : values) {
+        std::stringstream ss;
+        ss << x;
+
+        char buffer[32];
+        auto size = (Format(buffer, sizeof buffer) << x).size();
+        assert(std::string(buffer, size) == ss.str());
+    }
+
+    // Other precisions format as they do, without narrowing.
+    auto floats = {0.f, 7.99999f, -3.14159265f, 1e-45f, std::numeric_limits<float>::max()};
+    for (auto x : floats) {
+        std::stringstream ss;
+        ss << x;
+
+        char buffer[32];
+        auto size = (Format(buffer, sizeof buffer) << x).size();
+        assert(std::string(buffer, size) == ss.str());
+    }
+    auto longs = {0.L, 7.99999L, -3.14159265L, 1e4000L, -1e-4000L, std::numeric_limits<long double>::max(),
+                  std::numeric_limits<long double>::denorm_min()};
+    for (auto x : longs) {
+        std::stringstream ss;
+        ss << x;
+
+        char buffer[32];
+        auto size = (Format(buffer, sizeof buffer) << x).size();
+        assert(std::string(buffer, size) == ss.str());
+    }
+
+    // Output is truncated to the buffer, but its whole length is counted.
+    char buffer[8];
+    auto size = (Format(buffer, sizeof buffer) << "Point (" << 1.25 << ", " << 2. << ")").size();
+    assert(size == 15);
+    assert(std::string(buffer, sizeof buffer) == "Point (1");
+
+    std::string s;
+    format_to(Described(), std::back_inserter(s));
+    assert(s == "Described 1.5");
+
+    // Lengths can be measured without a buffer.
+    assert((Format(nullptr, 0) << "Point (" << 1.25 << ")").size() == 12);
+    assert(Described().format_to(nullptr, 0) == 13);
+
+    // Descriptions longer than DESCRIPTION_SIZE are described whole.
+    assert(describe(Described()) == "Described 1.5");
+    assert(describe(Long()) == std::string(DESCRIPTION_SIZE, 'x') + "x 1.5");
+}
+
+#endif
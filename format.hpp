@@ -0,0 +1,71 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <string>
+
+/// Largest description, in characters.
+constexpr std::size_t DESCRIPTION_SIZE = 256;
+
+/// Formats text and numbers into a caller-provided buffer, without allocating.
+/// @discussion Numbers are formatted as @c std::ostream formats them by default (as printf "%g"), via
+/// @c std::to_chars. Output beyond the buffer is dropped, but still counted by @c size, so a null buffer of
+/// size 0 measures it.
+class Format
+{
+public:
+    /// Construct formatter writing to @c buffer of @c size characters.
+    Format(char * buffer, std::size_t size);
+
+    /// Append @c text.
+    Format & operator<<(const char * text);
+
+    /// Append @c x, to 6 significant digits.
+    Format & operator<<(float x);
+
+    /// Append @c x, to 6 significant digits.
+    Format & operator<<(double x);
+
+    /// Append @c x, to 6 significant digits.
+    Format & operator<<(long double x);
+
+    /// @return std::size_t Length of the whole output, including any dropped.
+    std::size_t size() const;
+
+private:
+    void write(const char * text, std::size_t size);
+
+    /// Append @c x, to 6 significant digits.
+    template <typename T>
+    Format & number(T x);
+
+    char * next_;
+    char * last_;
+    std::size_t size_;
+};
+
+/// Format the description of @c value to output iterator @c out, without allocating.
+/// @return OutputIt Iterator past the last character written.
+template <typename T, typename OutputIt>
+OutputIt format_to(const T & value, OutputIt out)
+{
+    char buffer[DESCRIPTION_SIZE];
+    auto size = std::min(value.format_to(buffer, sizeof buffer), sizeof buffer);
+    return std::copy(buffer, buffer + size, out);
+}
+
+/// @return std::string Description of @c value, formatted by its @c format_to.
+/// @discussion Descriptions longer than @c DESCRIPTION_SIZE are formatted again, into the string, so are whole.
+template <typename T>
+std::string describe(const T & value)
+{
+    char buffer[DESCRIPTION_SIZE];
+    auto size = value.format_to(buffer, sizeof buffer);
+    if (size <= sizeof buffer) {
+        return std::string(buffer, size);
+    }
+
+    std::string s(size, '\0');
+    value.format_to(s.data(), s.size());
+    return s;
+}
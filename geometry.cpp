@@ -0,0 +1,107 @@
+#include "geometry.hpp"
+
+#ifdef UNITTEST_GEOMETRY
+
+#include <array>
+#include <cassert>
+#include <list>
+#include <vector>
+
+namespace
+{
+
+bool same(double x, double y)
+{
+    return x == y;
+}
+
+bool same(const Vector & x, const Vector & y)
+{
+    return x.tail().x() == y.tail().x() && x.tail().y() == y.tail().y()
+        && x.head().x() == y.head().x() && x.head().y() == y.head().y();
+}
+
+bool same(const Triangle & x, const Triangle & y)
+{
+    return x.a() == y.a() && x.b() == y.b() && x.c() == y.c()
+        && x.A().rad() == y.A().rad() && x.B().rad() == y.B().rad() && x.C().rad() == y.C().rad();
+}
+
+/// Check @c f gives the same results under every policy, and with forward iterators.
+template <typename T, typename F>
+void check(std::size_t size, const T & init, F f)
+{
+    std::vector<T> seq(size, init), par(size, init), par_unseq(size, init);
+    assert(f(std::execution::seq, seq.begin()) == seq.end());
+    assert(f(std::execution::par, par.begin()) == par.end());
+    assert(f(std::execution::par_unseq, par_unseq.begin()) == par_unseq.end());
+
+    std::list<T> list(size, init);
+    assert(f(std::execution::par, list.begin()) == list.end());
+
+    auto l = list.begin();
+    for (std::size_t i = 0; i < size; ++i, ++l) {
+        assert(same(seq[i], par[i]) && same(seq[i], par_unseq[i]) && same(seq[i], *l));
+    }
+}
+
+} // namespace
+
+int main()
+{
+    // Enough for several chunks.
+    constexpr std::size_t SIZE = 3 * ThreadPool::GRAIN + 5;
+
+    std::vector<Vector> vectors;
+    std::vector<std::array<double, 3>> sides;
+    for (std::size_t i = 0; i < SIZE; ++i) {
+        vectors.push_back(Vector(Point(i * 0.25, -1. * i), Point(i % 7, i * 0.125)));
+        sides.push_back({3. + i % 5, 4. + i % 3, 5. + i % 2});
+    }
+
+    auto v = vectors.begin(), w = vectors.end();
+    check(SIZE, Vector(Point()), [&](auto && policy, auto out) {
+        return geometry::translate(policy, v, w, out, Point(1, -2));
+    });
+    check(SIZE, Vector(Point()), [&](auto && policy, auto out) {
+        return geometry::rotate(policy, v, w, out, Angle::degrees(33));
+    });
+    check(SIZE, Vector(Point()), [&](auto && policy, auto out) {
+        return geometry::apply(policy, v, w, out, Transform().rotate(Angle::degrees(33)).translate(Point(1, -2)));
+    });
+    check(SIZE, 0., [&](auto && policy, auto out) {
+        return geometry::magnitude(policy, v, w, out);
+    });
+    check(SIZE, Triangle(1, 1, 1), [&](auto && policy, auto out) {
+        return geometry::solve(policy, sides.begin(), sides.end(), out);
+    });
+    check(SIZE, Triangle(1, 1, 1), [&](auto && policy, auto out) {
+        return geometry::solve<trig::Minimax<4>>(policy, sides.begin(), sides.end(), out);
+    });
+
+    // Results match the scalar path.
+    std::vector<Vector> r(SIZE, Vector(Point()));
+    geometry::rotate(std::execution::par, v, w, r.begin(), Angle::degrees(33));
+    geometry::translate(std::execution::par, r.begin(), r.end(), r.begin(), Point(1, -2));
+    std::vector<double> m(SIZE);
+    geometry::magnitude(std::execution::par_unseq, r.begin(), r.end(), m.begin());
+    std::vector<Triangle> t(SIZE, Triangle(1, 1, 1));
+    geometry::solve(std::execution::par, sides.begin(), sides.end(), t.begin());
+    std::vector<Vector> a(SIZE, Vector(Point()));
+    auto transform = Transform::rotation(Angle::degrees(33)) * Transform::translation(Point(1, -2));
+    geometry::apply(std::execution::par, v, w, a.begin(), transform);
+    for (std::size_t i = 0; i < SIZE; ++i) {
+        auto x = Vector::translate(Vector::rotate(vectors[i], Angle::degrees(33)), Point(1, -2));
+        assert(same(r[i], x));
+        assert(same(a[i], transform.apply(vectors[i])));
+        assert(m[i] == x.magnitude());
+        assert(same(t[i], Triangle(sides[i][0], sides[i][1], sides[i][2])));
+    }
+
+    // Output iterators need not be random access.
+    std::vector<double> b;
+    geometry::magnitude(std::execution::par, v, v + 3, std::back_inserter(b));
+    assert(b.size() == 3 && b[2] == vectors[2].magnitude());
+}
+
+#endif
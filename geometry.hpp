@@ -0,0 +1,136 @@
+#pragma once
+
+#include "angle.hpp"
+#include "point.hpp"
+#include "threadpool.hpp"
+#include "transform.hpp"
+#include "triangle.hpp"
+#include "trig.hpp"
+#include "unitangle.hpp"
+#include "vector.hpp"
+
+#include <cstddef>
+#include <execution>
+#include <iterator>
+#include <tuple>
+#include <type_traits>
+
+/// Bulk operations on ranges of geometry types, under a standard execution policy.
+/// @discussion Under @c std::execution::seq, or unless both iterators are random access, elements are visited in
+/// order on the calling thread. Under @c par and @c par_unseq they are visited in chunks of @c ThreadPool::GRAIN
+/// on @c ThreadPool::shared. Each result depends only on its own element, so results are identical under every
+/// policy. Output iterators must not overlap the input, unless equal to @c first.
+/// Call these qualified, as @c geometry::rotate, since an unqualified call may find @c std::rotate.
+namespace geometry
+{
+
+/// Store @c f(x) for each @c x in [@c first, @c last) to @c out, under @c policy.
+/// @return OutputIt Iterator past the last element stored.
+template <typename ExecutionPolicy, typename InputIt, typename OutputIt, typename F>
+OutputIt transform(ExecutionPolicy && policy, InputIt first, InputIt last, OutputIt out, F f);
+
+/// Store vectors in [@c first, @c last) translated to @c point, to @c out.
+/// @see Vector::translate
+/// @return OutputIt Iterator past the last vector stored.
+template <typename ExecutionPolicy, typename InputIt, typename OutputIt>
+OutputIt translate(ExecutionPolicy && policy, InputIt first, InputIt last, OutputIt out, const Point & point);
+
+/// Store vectors in [@c first, @c last) rotated by @c direction, to @c out.
+/// @discussion The sine and cosine of @c direction are found once, for the whole range.
+/// @see Vector::rotate
+/// @return OutputIt Iterator past the last vector stored.
+template <typename ExecutionPolicy, typename InputIt, typename OutputIt>
+OutputIt rotate(ExecutionPolicy && policy, InputIt first, InputIt last, OutputIt out, const Angle & direction);
+
+/// Store vectors in [@c first, @c last) with @c transform applied to their tails and heads, to @c out.
+/// @see Transform::apply
+/// @return OutputIt Iterator past the last vector stored.
+template <typename ExecutionPolicy, typename InputIt, typename OutputIt>
+OutputIt apply(ExecutionPolicy && policy, InputIt first, InputIt last, OutputIt out, const Transform & transform);
+
+/// Store magnitudes of vectors in [@c first, @c last) to @c out.
+/// @see Vector::magnitude
+/// @return OutputIt Iterator past the last magnitude stored.
+template <typename ExecutionPolicy, typename InputIt, typename OutputIt>
+OutputIt magnitude(ExecutionPolicy && policy, InputIt first, InputIt last, OutputIt out);
+
+/// Store triangles having the sides in [@c first, @c last) to @c out, with their angles solved.
+/// @discussion Sides are tuple-like (@c std::get<0> to @c std::get<2> are @c a, @c b and @c c), such as
+/// @c std::array<double, 3>. Angles are solved eagerly, with trigonometry policy @c Trig, on the worker threads.
+/// @see Triangle::with_a_b_c
+/// @return OutputIt Iterator past the last triangle stored.
+template <typename Trig = trig::Libm, typename ExecutionPolicy, typename InputIt, typename OutputIt>
+OutputIt solve(ExecutionPolicy && policy, InputIt first, InputIt last, OutputIt out);
+
+template <typename ExecutionPolicy, typename InputIt, typename OutputIt, typename F>
+OutputIt transform(ExecutionPolicy &&, InputIt first, InputIt last, OutputIt out, F f)
+{
+    using Policy = std::decay_t<ExecutionPolicy>;
+    static_assert(std::is_execution_policy_v<Policy>, "policy must be a standard execution policy");
+
+    using Random = std::random_access_iterator_tag;
+    constexpr auto random = std::is_base_of_v<Random, typename std::iterator_traits<InputIt>::iterator_category>
+        && std::is_base_of_v<Random, typename std::iterator_traits<OutputIt>::iterator_category>;
+
+    if constexpr (std::is_same_v<Policy, std::execution::sequenced_policy> || !random) {
+        for (; first != last; ++first, ++out) {
+            *out = f(*first);
+        }
+        return out;
+    } else {
+        auto size = static_cast<std::size_t>(last - first);
+        ThreadPool::shared().run(size, ThreadPool::GRAIN, [&](std::size_t begin, std::size_t end) {
+            for (auto i = begin; i < end; ++i) {
+                out[i] = f(first[i]);
+            }
+        });
+        return out + size;
+    }
+}
+
+template <typename ExecutionPolicy, typename InputIt, typename OutputIt>
+OutputIt translate(ExecutionPolicy && policy, InputIt first, InputIt last, OutputIt out, const Point & point)
+{
+    return geometry::transform(std::forward<ExecutionPolicy>(policy), first, last, out, [&point](const Vector & v) {
+        return Vector::translate(v, point);
+    });
+}
+
+template <typename ExecutionPolicy, typename InputIt, typename OutputIt>
+OutputIt rotate(ExecutionPolicy && policy, InputIt first, InputIt last, OutputIt out, const Angle & direction)
+{
+    // Find the sine and cosine once, rather than once per vector.
+    const auto unit = UnitAngle(direction);
+    return geometry::transform(std::forward<ExecutionPolicy>(policy), first, last, out, [unit](const Vector & v) {
+        return Vector::rotate(v, unit);
+    });
+}
+
+template <typename ExecutionPolicy, typename InputIt, typename OutputIt>
+OutputIt apply(ExecutionPolicy && policy, InputIt first, InputIt last, OutputIt out, const Transform & transform)
+{
+    return geometry::transform(std::forward<ExecutionPolicy>(policy), first, last, out, [&transform](const Vector & v) {
+        return transform.apply(v);
+    });
+}
+
+template <typename ExecutionPolicy, typename InputIt, typename OutputIt>
+OutputIt magnitude(ExecutionPolicy && policy, InputIt first, InputIt last, OutputIt out)
+{
+    return geometry::transform(std::forward<ExecutionPolicy>(policy), first, last, out, [](const Vector & v) {
+        return v.magnitude();
+    });
+}
+
+template <typename Trig, typename ExecutionPolicy, typename InputIt, typename OutputIt>
+OutputIt solve(ExecutionPolicy && policy, InputIt first, InputIt last, OutputIt out)
+{
+    return geometry::transform(std::forward<ExecutionPolicy>(policy), first, last, out, [](const auto & sides) {
+        auto t = Triangle::with_a_b_c<Trig>(std::get<0>(sides), std::get<1>(sides), std::get<2>(sides));
+        // B depends on A, which depends on C, so this solves and caches every angle.
+        t.B();
+        return t;
+    });
+}
+
+} // namespace geometry
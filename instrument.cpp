@@ -0,0 +1,244 @@
+#include "instrument.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cinttypes>
+#include <mutex>
+#include <vector>
+
+namespace
+{
+
+/// Counts of a thread, registered while it runs.
+struct Counters
+{
+    Counters();
+    ~Counters();
+
+    std::atomic<std::uint64_t> counts[instrument::EVENTS]{};
+};
+
+/// Counters of running threads, and the counts of exited threads.
+struct Registry
+{
+    std::mutex mutex;
+    std::vector<Counters *> threads;
+    std::uint64_t exited[instrument::EVENTS];
+};
+
+Registry & registry()
+{
+    static Registry registry{};
+    return registry;
+}
+
+Counters::Counters()
+{
+    // The registry is constructed first, so outlives the counters of every thread.
+    auto & r = registry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+    r.threads.push_back(this);
+}
+
+Counters::~Counters()
+{
+    auto & r = registry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+    for (unsigned i = 0; i < instrument::EVENTS; ++i) {
+        r.exited[i] += counts[i].load(std::memory_order_relaxed);
+    }
+    r.threads.erase(std::find(r.threads.begin(), r.threads.end(), this));
+}
+
+thread_local Counters counters;
+
+} // namespace
+
+namespace instrument
+{
+
+void count(Event event)
+{
+    counters.counts[event].fetch_add(1, std::memory_order_relaxed);
+}
+
+Snapshot snapshot()
+{
+    auto & r = registry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+
+    Snapshot s{};
+    for (unsigned i = 0; i < EVENTS; ++i) {
+        s.counts[i] = r.exited[i];
+        for (auto c : r.threads) {
+            s.counts[i] += c->counts[i].load(std::memory_order_relaxed);
+        }
+    }
+    return s;
+}
+
+Snapshot local()
+{
+    Snapshot s{};
+    for (unsigned i = 0; i < EVENTS; ++i) {
+        s.counts[i] = counters.counts[i].load(std::memory_order_relaxed);
+    }
+    return s;
+}
+
+void reset()
+{
+    auto & r = registry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+
+    for (unsigned i = 0; i < EVENTS; ++i) {
+        r.exited[i] = 0;
+        for (auto c : r.threads) {
+            c->counts[i].store(0, std::memory_order_relaxed);
+        }
+    }
+}
+
+const char * name(Event event)
+{
+    static const char * const names[EVENTS] = {
+        "trig",
+        "reduce",
+        "right_angled_triangle",
+        "triangle_solve",
+    };
+    return event < EVENTS ? names[event] : "";
+}
+
+bool dump(const Snapshot & snapshot, std::FILE * file)
+{
+    for (unsigned i = 0; i < EVENTS; ++i) {
+        if (std::fprintf(file, "%s %" PRIu64 "\n", name(Event(i)), snapshot.counts[i]) < 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+Snapshot operator-(const Snapshot & x, const Snapshot & y)
+{
+    Snapshot s{};
+    for (unsigned i = 0; i < EVENTS; ++i) {
+        s.counts[i] = x.counts[i] - y.counts[i];
+    }
+    return s;
+}
+
+} // namespace instrument
+
+#ifdef UNITTEST_INSTRUMENT
+
+#include "geometry.hpp"
+#include "isoscelestriangle.hpp"
+#include "path.hpp"
+#include "triangle.hpp"
+#include "vector.hpp"
+
+#include <cassert>
+#include <cstring>
+#include <execution>
+#include <thread>
+
+int main()
+{
+    using namespace instrument;
+
+    reset();
+    assert(snapshot().counts[TRIG] == 0);
+
+    count(TRIG);
+    count(TRIG);
+    count(REDUCE);
+    auto before = snapshot();
+    assert(before.counts[TRIG] == 2 && before.counts[REDUCE] == 1 && before.counts[TRIANGLE_SOLVE] == 0);
+    assert(local().counts[TRIG] == 2);
+
+    // Counts of other threads are summed, and kept once they exit.
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([] {
+            for (int i = 0; i < 1000; ++i) {
+                count(RIGHT_ANGLED_TRIANGLE);
+            }
+            assert(local().counts[RIGHT_ANGLED_TRIANGLE] == 1000 && local().counts[TRIG] == 0);
+        });
+    }
+    for (auto & thread : threads) {
+        thread.join();
+    }
+
+    auto after = snapshot();
+    auto d = after - before;
+    assert(d.counts[RIGHT_ANGLED_TRIANGLE] == 4000 && d.counts[TRIG] == 0);
+    assert(local().counts[RIGHT_ANGLED_TRIANGLE] == 0);
+
+    assert(std::strcmp(name(TRIG), "trig") == 0);
+    assert(std::strcmp(name(TRIANGLE_SOLVE), "triangle_solve") == 0);
+    assert(std::strcmp(name(EVENTS), "") == 0);
+
+    auto file = std::tmpfile();
+    assert(dump(after, file));
+    std::rewind(file);
+    char text[256] = {};
+    assert(std::fread(text, 1, sizeof(text) - 1, file) > 0);
+    assert(std::strcmp(text, "trig 2\nreduce 1\nright_angled_triangle 4000\ntriangle_solve 0\n") == 0);
+    std::fclose(file);
+
+    // Writing to a read-only stream fails.
+    file = std::fopen("/dev/null", "r");
+    assert(!dump(after, file));
+    std::fclose(file);
+
+    // Reset clears running and exited threads alike.
+    reset();
+    after = snapshot();
+    for (auto c : after.counts) {
+        assert(c == 0);
+    }
+    assert(local().counts[TRIG] == 0);
+
+#ifdef TRIG_INSTRUMENT
+    // Real calls move the counters, once each.
+    auto counted = [](auto f) {
+        auto before = snapshot();
+        f();
+        return snapshot() - before;
+    };
+
+    auto t = IsoscelesTriangle(Angle::degrees(40), 5);
+    d = counted([&] { t.base(); });
+    assert(d.counts[RIGHT_ANGLED_TRIANGLE] == 1 && d.counts[TRIG] == 2);
+    d = counted([&] { t.base(); });
+    assert(d.counts[RIGHT_ANGLED_TRIANGLE] == 0 && d.counts[TRIG] == 0);
+
+    d = counted([] { Vector(Angle::degrees(30), 5); });
+    assert(d.counts[TRIG] == 2);
+    d = counted([] { Vector(Point(3, 4)).direction(); });
+    assert(d.counts[TRIG] == 1);
+
+    auto u = Triangle(3, 4, 5);
+    d = counted([&] { u.A(); });
+    assert(d.counts[TRIANGLE_SOLVE] == 1 && d.counts[TRIG] == 3);
+
+    d = counted([] { Angle::radians(1e300); });
+    assert(d.counts[REDUCE] == 1 && d.counts[TRIG] == 3);
+
+    auto p = Path(Point(), Angle::degrees(45));
+    p.add(Angle::degrees(90), 1);
+    d = counted([&] { p.closure(); });
+    assert(d.counts[TRIG] == 0);
+
+    auto vectors = std::vector<Vector>(1000, Vector(Point(3, 4)));
+    d = counted([&] { geometry::rotate(std::execution::seq, vectors.begin(), vectors.end(), vectors.begin(), Angle::degrees(30)); });
+    assert(d.counts[TRIG] == 2);
+    d = counted([&] { geometry::rotate(std::execution::par, vectors.begin(), vectors.end(), vectors.begin(), Angle::degrees(30)); });
+    assert(d.counts[TRIG] == 2);
+#endif
+}
+
+#endif
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+
+/// Counters of events on hot paths, to attribute cost to call sites without a profiler.
+/// @discussion Events are counted only in builds with @c TRIG_INSTRUMENT defined, such as
+/// `make CFLAGS="-std=c++17 -O2 -DTRIG_INSTRUMENT"`; otherwise @c TRIG_COUNT expands to nothing.
+/// Each thread counts into its own counters, with relaxed atomics, so counting never contends. Snapshots sum
+/// the counts of every thread, including threads that have exited.
+namespace instrument
+{
+
+/// Events counted.
+enum Event : unsigned
+{
+    /// Call to a trigonometric function: through a policy (@see trig.hpp), or to libm directly.
+    TRIG,
+    /// Reduction of an angle from outside 0..2π.
+    REDUCE,
+    /// Construction of a right-angled triangle, including those made within other solvers.
+    RIGHT_ANGLED_TRIANGLE,
+    /// Solve of triangle angles on first access.
+    TRIANGLE_SOLVE,
+    EVENTS
+};
+
+/// Counts of each event.
+struct Snapshot
+{
+    std::uint64_t counts[EVENTS];
+};
+
+/// Count @c event on this thread.
+void count(Event event);
+
+/// @return Snapshot Counts on all threads, since the last reset.
+Snapshot snapshot();
+
+/// @return Snapshot Counts on this thread, since the last reset.
+Snapshot local();
+
+/// Reset counts on all threads to zero.
+void reset();
+
+/// @return const char * Name of @c event.
+const char * name(Event event);
+
+/// Write @c snapshot to @c file, as a line of "name count" per event.
+/// @return bool Whether it was written.
+bool dump(const Snapshot & snapshot, std::FILE * file);
+
+/// @return Snapshot Counts in @c x since @c y.
+Snapshot operator-(const Snapshot & x, const Snapshot & y);
+
+} // namespace instrument
+
+#ifdef TRIG_INSTRUMENT
+#define TRIG_COUNT(event) instrument::count(instrument::event)
+#else
+#define TRIG_COUNT(event) ((void)0)
+#endif
@@ -1,92 +1,66 @@
 #include "isoscelestriangle.hpp"
 
-#include "angle.hpp"
-#include "rightangledtriangle.hpp"
+#include "format.hpp"
 
-#include <cmath>
-#include <sstream>
-
-namespace
-{
-
-/// @return @c x squared.
-inline double sqr(double x)
+template <typename T>
+BasicIsoscelesTriangle<T>::BasicIsoscelesTriangle(const BasicIsoscelesTriangle & other) :
+    V_{other.V_}, B_{other.B_}, side_{other.side_}, base_{0.}, height_{0.}, known_{0}
 {
-    return pow(x, 2);
+    *this = other;
 }
 
-} // namespace
-
-IsoscelesTriangle::IsoscelesTriangle(const Angle & V, double side) : V_{V}, side_{side}
+template <typename T>
+BasicIsoscelesTriangle<T> & BasicIsoscelesTriangle<T>::operator=(const BasicIsoscelesTriangle & other)
 {
+    // Base and height are read only once known, so copying races with no other thread solving them.
+    auto known = static_cast<unsigned char>(other.known_.load(std::memory_order_acquire) & KNOWN);
+    V_ = other.V_;
+    B_ = other.B_;
+    side_ = other.side_;
+    base_ = known ? other.base_ : T(0);
+    height_ = known ? other.height_ : T(0);
+    known_.store(known, std::memory_order_relaxed);
+    return *this;
 }
 
-Angle IsoscelesTriangle::vertexAngle() const
+template <typename T>
+std::string BasicIsoscelesTriangle<T>::description() const
 {
-    return V_;
+    return describe(*this);
 }
 
-Angle IsoscelesTriangle::baseAngle() const
+template <typename T>
+std::size_t BasicIsoscelesTriangle<T>::format_to(char * buffer, std::size_t size) const
 {
-    //       V
-    //       +
-    //      / \    .
-    //     /   \   .
-    //    /     \  .
-    //   /       \ .
-    //  +----+----+
-    //  B         B
-
-    // 180° total
-    return Angle::radians((Angle::degrees(180) - V_) / 2.);
-}
-
-double IsoscelesTriangle::side() const
-{
-    return side_;
-}
-
-double IsoscelesTriangle::base() const
-{
-    //       A
-    //       +
-    //       |\     .
-    //       | \    .
-    //       |  \ c .
-    //       |   \  .
-    //       +----+
-    //         a
-
-    auto r = RightAngledTriangle::with_A_c(V_ / 2., side());
-    return r.a() * 2;
-}
-
-double IsoscelesTriangle::height() const
-{
-    // Given Pythagoras theorem: Hypotenuse² = Base² + Height²
-    // Then h² = side² - (base/2)²
-    // Or   h  = √(side² - (base/2)²)
-    return sqrt(sqr(side()) - sqr(base() / 2));
-}
-
-std::string IsoscelesTriangle::description() const
-{
-    std::stringstream ss;
-    ss << "IsoscelesTriangle "
+    return (Format(buffer, size) << "IsoscelesTriangle "
         << side() << ", " << base() << "; "
         << vertexAngle() << " (" << vertexAngle().deg() << "°), "
-        << baseAngle() << " (" << baseAngle().deg() << "°)";
-    return ss.str();
+        << baseAngle() << " (" << baseAngle().deg() << "°)").size();
 }
 
+template class BasicIsoscelesTriangle<float>;
+template class BasicIsoscelesTriangle<double>;
+template class BasicIsoscelesTriangle<long double>;
+
 #ifdef UNITTEST_ISOSCELESTRIANGLE
 
-#include "fcmp.h"
+#include "fcmp.hpp"
 
 #include <cassert>
+#include <thread>
+#include <vector>
 
-int main()
+namespace
 {
+
+/// Check isosceles triangles in precision @c T.
+template <typename T>
+void test()
+{
+    using Angle = BasicAngle<T>;
+    using IsoscelesTriangle = BasicIsoscelesTriangle<T>;
+    using RightAngledTriangle = BasicRightAngledTriangle<T>;
+
     {
         auto t = IsoscelesTriangle(Angle::degrees(40), 5);
         assert(fcmp(t.vertexAngle(), Angle::degrees(40)));
@@ -94,7 +68,7 @@ int main()
         assert(fcmp(t.side(), 5.00));
         assert(fcmp(t.base(), 3.42));
 
-        auto r = RightAngledTriangle::with_A_c(t.vertexAngle() / 2., t.side());
+        auto r = RightAngledTriangle::with_A_c(t.vertexAngle() / T(2), t.side());
         assert(fcmp(t.height(), r.b()));
         assert(fcmp(t.height(), 4.698));
     }
@@ -109,6 +83,62 @@ int main()
 
         assert(t.description() == "IsoscelesTriangle 5, 7.99999; 1.85459 (106.26°), 0.643503 (36.87°)");
     }
+
+    {
+        // Cached measurements are identical to those solved afresh, for each policy.
+        auto t = IsoscelesTriangle(Angle::degrees(40), 5);
+        auto r = RightAngledTriangle::with_A_c(t.vertexAngle() / T(2), t.side());
+        auto base = r.a() * 2;
+        auto height = std::sqrt(25 - (base / 2) * (base / 2));
+        assert(t.height() == height);
+        assert(t.base() == base && t.height() == height);
+
+        auto f = RightAngledTriangle::template with_A_c<trig::Minimax<3>>(t.vertexAngle() / T(2), t.side());
+        assert(t.template base<trig::Minimax<3>>() == f.a() * 2);
+        assert(t.template base<trig::Minimax<3>>() != base);
+        assert(t.base() == base);
+
+        assert(fcmp(IsoscelesTriangle(Angle::degrees(100), 1).baseAngle(), Angle::degrees(40)));
+    }
+
+    {
+        // Copies carry the cached base and height.
+        auto t = IsoscelesTriangle(Angle::degrees(40), 5);
+        auto u = t;
+        auto base = t.base();
+        auto v = t;
+        u = v;
+        assert(u.base() == base && v.height() == t.height());
+        assert(u.template base<trig::Minimax<3>>() == t.template base<trig::Minimax<3>>());
+    }
+
+    {
+        // Const triangles may be measured from many threads at once.
+        const auto t = IsoscelesTriangle(Angle::degrees(40), 5);
+        const auto base = IsoscelesTriangle(Angle::degrees(40), 5).base();
+        std::vector<std::thread> threads;
+        for (auto i = 0; i < 4; ++i) {
+            threads.emplace_back([&t, base] {
+                for (auto j = 0; j < 100; ++j) {
+                    assert(t.base() == base);
+                }
+            });
+        }
+        for (auto & thread : threads) {
+            thread.join();
+        }
+    }
+}
+
+} // namespace
+
+int main()
+{
+    test<float>();
+    test<double>();
+    test<long double>();
+
+    static_assert(IsoscelesTriangle(Angle::degrees(100), 1).baseAngle() == Angle::degrees(40));
 }
 
 #endif
@@ -1,8 +1,14 @@
 #pragma once
 
 #include "angle.hpp"
+#include "rightangledtriangle.hpp"
+#include "trig.hpp"
 
+#include <atomic>
+#include <cmath>
+#include <cstddef>
 #include <string>
+#include <type_traits>
 
 /// Models an isosceles triangle.
 /// ```
@@ -14,31 +20,165 @@
 ///   +---------+
 ///       base
 /// ```
-class IsoscelesTriangle
+/// The base angle is found on construction; base and height on first access. Those found with the default
+/// (libm) trigonometry policy are cached; other policies solve afresh on each access.
+/// Const member functions may be called concurrently: the cache is published by an atomic flag (release on
+/// store, acquire on load), and only one thread at a time stores to it.
+/// Instantiated for @c float, @c double and @c long double.
+/// @see IsoscelesTriangle
+template <typename T>
+class BasicIsoscelesTriangle
 {
 public:
+    using Angle = BasicAngle<T>;
+
     /// Construct triangle with vertex angle @c V and side length @c side.
-    IsoscelesTriangle(const Angle & V, double side);
+    constexpr BasicIsoscelesTriangle(const Angle & V, T side);
+
+    /// Construct copy of @c other, with its base and height if already known.
+    BasicIsoscelesTriangle(const BasicIsoscelesTriangle & other);
+
+    /// Assign copy of @c other, with its base and height if already known.
+    BasicIsoscelesTriangle & operator=(const BasicIsoscelesTriangle & other);
 
     /// @return double Vertex angle @c V.
-    Angle vertexAngle() const;
+    constexpr Angle vertexAngle() const;
 
     /// @return double Computed base angle.
-    Angle baseAngle() const;
+    constexpr Angle baseAngle() const;
 
-    /// @return double Length of side.
-    double side() const;
+    /// @return T Length of side.
+    constexpr T side() const;
 
-    /// @return double Computed length of base.
-    double base() const;
+    /// @return T Computed length of base.
+    template <typename Trig = trig::Libm>
+    T base() const;
 
-    /// @return double Computed height.
-    double height() const;
+    /// @return T Computed height.
+    template <typename Trig = trig::Libm>
+    T height() const;
 
     /// @return std::string Description.
     std::string description() const;
 
+    /// Format description into @c buffer of @c size characters, without allocating.
+    /// @discussion Writes at most @c size characters, without a terminator; the output matches @c description.
+    /// @see format_to(const T &, OutputIt) to format to an output iterator.
+    /// @return std::size_t Length of the whole description.
+    std::size_t format_to(char * buffer, std::size_t size) const;
+
 private:
+    /// Bits of @c known_.
+    enum : unsigned char
+    {
+        KNOWN = 1,
+        SOLVING = 2,
+    };
+
+    /// Solve @c base and @c height with trigonometry policy @c Trig, caching them for the default policy.
+    template <typename Trig>
+    void solve(T & base, T & height) const;
+
     Angle V_;
-    double side_;
+    Angle B_;
+    T side_;
+    mutable T base_;
+    mutable T height_;
+    mutable std::atomic<unsigned char> known_;
 };
+
+/// Isosceles triangle in double precision.
+using IsoscelesTriangle = BasicIsoscelesTriangle<double>;
+
+//       V
+//       +
+//      / \    .
+//     /   \   .
+//    /     \  .
+//   /       \ .
+//  +----+----+
+//  B         B
+template <typename T>
+constexpr BasicIsoscelesTriangle<T>::BasicIsoscelesTriangle(const Angle & V, T side) :
+    V_{V},
+    B_{Angle::radians((Angle::degrees(180) - V) / T(2))}, // 180° total
+    side_{side},
+    base_{0.},
+    height_{0.},
+    known_{0}
+{
+}
+
+template <typename T>
+constexpr BasicAngle<T> BasicIsoscelesTriangle<T>::vertexAngle() const
+{
+    return V_;
+}
+
+template <typename T>
+constexpr BasicAngle<T> BasicIsoscelesTriangle<T>::baseAngle() const
+{
+    return B_;
+}
+
+template <typename T>
+constexpr T BasicIsoscelesTriangle<T>::side() const
+{
+    return side_;
+}
+
+template <typename T>
+template <typename Trig>
+T BasicIsoscelesTriangle<T>::base() const
+{
+    if (std::is_same_v<Trig, trig::Libm> && (known_.load(std::memory_order_acquire) & KNOWN)) {
+        return base_;
+    }
+    T base, height;
+    solve<Trig>(base, height);
+    return base;
+}
+
+template <typename T>
+template <typename Trig>
+T BasicIsoscelesTriangle<T>::height() const
+{
+    if (std::is_same_v<Trig, trig::Libm> && (known_.load(std::memory_order_acquire) & KNOWN)) {
+        return height_;
+    }
+    T base, height;
+    solve<Trig>(base, height);
+    return height;
+}
+
+template <typename T>
+template <typename Trig>
+void BasicIsoscelesTriangle<T>::solve(T & base, T & height) const
+{
+    //       A
+    //       +
+    //       |\     .
+    //       | \    .
+    //       |  \ c .
+    //       |   \  .
+    //       +----+
+    //         a
+
+    auto r = BasicRightAngledTriangle<T>::template with_A_c<Trig>(V_ / T(2), side());
+    base = r.a() * 2;
+
+    // Given Pythagoras theorem: Hypotenuse² = Base² + Height²
+    // Then h² = side² - (base/2)²
+    // Or   h  = √(side² - (base/2)²)
+    auto half = base / 2;
+    height = std::sqrt(side() * side() - half * half);
+
+    // Store only if no other thread is storing.
+    if (std::is_same_v<Trig, trig::Libm> && !(known_.fetch_or(SOLVING, std::memory_order_acquire) & SOLVING)) {
+        if (!(known_.load(std::memory_order_relaxed) & KNOWN)) {
+            base_ = base;
+            height_ = height;
+        }
+        known_.store(KNOWN, std::memory_order_release);
+    }
+}
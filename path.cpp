@@ -0,0 +1,266 @@
+#include "path.hpp"
+
+#include <cmath>
+
+namespace
+{
+
+/// Compensated (Kahan) sum, carrying the low-order bits lost by each addition.
+/// @see https://en.wikipedia.org/wiki/Kahan_summation_algorithm
+template <typename T>
+struct Sum
+{
+    /// Add @c x.
+    void add(T x)
+    {
+        auto y = x - error;
+        auto t = sum + y;
+        error = (t - sum) - y;
+        sum = t;
+    }
+
+    T sum;
+    T error;
+};
+
+} // namespace
+
+template <typename T>
+BasicPath<T>::BasicPath(const Point & start, const Angle & direction) :
+    start_{start}, direction_{direction}, turns_{}, turnsError_{}, segments_{}
+{
+}
+
+template <typename T>
+BasicPath<T> & BasicPath<T>::add(const Angle & turn, T length)
+{
+    return add(UnitAngle(turn), length);
+}
+
+template <typename T>
+BasicPath<T> & BasicPath<T>::add(const UnitAngle & turn, T length)
+{
+    segments_.push_back(Segment{turn.cos(), turn.sin(), length});
+
+    auto turns = Sum<T>{turns_, turnsError_};
+    turns.add(turn.rad());
+    turns_ = turns.sum;
+    turnsError_ = turns.error;
+    return *this;
+}
+
+template <typename T>
+template <typename F>
+void BasicPath<T>::walk(F f) const
+{
+    auto c = direction_.cos();
+    auto s = direction_.sin();
+    auto x = Sum<T>{start_.x(), 0};
+    auto y = Sum<T>{start_.y(), 0};
+
+    f(start_);
+    for (auto & segment : segments_) {
+        // Rotate the heading: (c + is)(cos + isin).
+        auto rc = c * segment.cos - s * segment.sin;
+        auto rs = c * segment.sin + s * segment.cos;
+        // One Newton step towards unit length, so rounding does not compound.
+        auto k = (3 - (rc * rc + rs * rs)) / 2;
+        c = rc * k;
+        s = rs * k;
+
+        x.add(segment.length * c);
+        y.add(segment.length * s);
+        f(Point{x.sum - x.error, y.sum - y.error});
+    }
+}
+
+template <typename T>
+void BasicPath<T>::vertices(Point * out) const
+{
+    walk([&out](const Point & p) {
+        *out++ = p;
+    });
+}
+
+template <typename T>
+std::vector<BasicPoint<T>> BasicPath<T>::vertices() const
+{
+    std::vector<Point> v(size() + 1);
+    vertices(v.data());
+    return v;
+}
+
+template <typename T>
+BasicPoint<T> BasicPath<T>::start() const
+{
+    return start_;
+}
+
+template <typename T>
+BasicPoint<T> BasicPath<T>::end() const
+{
+    Point end;
+    walk([&end](const Point & p) {
+        end = p;
+    });
+    return end;
+}
+
+template <typename T>
+BasicAngle<T> BasicPath<T>::heading() const
+{
+    return Angle::radians(direction_.rad() + (turns_ - turnsError_));
+}
+
+template <typename T>
+BasicPoint<T> BasicPath<T>::gap() const
+{
+    return start_ - end();
+}
+
+template <typename T>
+T BasicPath<T>::closure() const
+{
+    auto g = gap();
+    return std::hypot(g.x(), g.y());
+}
+
+template <typename T>
+void BasicPath<T>::closure(const BasicPath * paths, std::size_t size, T * out)
+{
+    for (std::size_t i = 0; i < size; ++i) {
+        out[i] = paths[i].closure();
+    }
+}
+
+template <typename T>
+void BasicPath<T>::closure(ThreadPool & pool, const BasicPath * paths, std::size_t size, T * out, std::size_t grain)
+{
+    pool.run(size, grain, [&](std::size_t begin, std::size_t end) {
+        closure(paths + begin, end - begin, out + begin);
+    });
+}
+
+template <typename T>
+std::size_t BasicPath<T>::size() const
+{
+    return segments_.size();
+}
+
+template class BasicPath<float>;
+template class BasicPath<double>;
+template class BasicPath<long double>;
+
+#ifdef UNITTEST_PATH
+
+#include "fcmp.hpp"
+#include "vector.hpp"
+
+#include <cassert>
+#include <initializer_list>
+#include <limits>
+
+namespace
+{
+
+/// @return bool Whether points @c p and @c q match to @c precision decimal places.
+template <typename T>
+bool near(const BasicPoint<T> & p, const BasicPoint<T> & q, int precision)
+{
+    return fcmp(p.x(), q.x(), precision) && fcmp(p.y(), q.y(), precision);
+}
+
+/// Check paths in precision @c T.
+template <typename T>
+void test()
+{
+    using Angle = BasicAngle<T>;
+    using Path = BasicPath<T>;
+    using Point = BasicPoint<T>;
+    using Vector = BasicVector<T>;
+
+    constexpr int precision = std::numeric_limits<T>::digits10 - 3;
+
+    // An empty path is closed.
+    {
+        auto p = Path(Point{1, 2}, Angle::degrees(30));
+        assert(p.size() == 0);
+        assert(p.vertices().size() == 1);
+        assert(near(p.start(), Point{1, 2}, precision));
+        assert(near(p.end(), Point{1, 2}, precision));
+        assert(fcmp(p.heading(), Angle::degrees(30), precision));
+        assert(p.closure() == 0);
+    }
+
+    // The square walked by chaining vectors, from (0,0) heading along (3,4).
+    {
+        auto u = Vector(Point{3, 4});
+        auto p = Path(Point{}, u.direction());
+        p.add(Angle(), 5);
+        for (auto i = 0; i < 3; ++i) {
+            p.add(Angle::degrees(90), 5);
+        }
+
+        auto v = p.vertices();
+        assert(p.size() == 4 && v.size() == 5);
+        assert(near(v[0], Point{0, 0}, precision));
+        assert(near(v[1], Point{3, 4}, precision));
+        assert(near(v[2], Point{-1, 7}, precision));
+        assert(near(v[3], Point{-4, 3}, precision));
+        assert(near(v[4], Point{0, 0}, precision));
+        assert(fcmp(p.heading(), u.direction() + Angle::degrees(270), precision));
+        assert(fcmp(p.closure(), 0, precision));
+
+        // Continuing round matches the vector chain.
+        auto w = Vector(Angle::degrees(90), 5).rotate(Vector(v[3], v[4]).direction()).translate(v[4]);
+        p.add(Angle::degrees(90), 5);
+        assert(near(p.end(), w.head(), precision));
+        assert(near(p.gap(), Point{-3, -4}, precision));
+        assert(fcmp(p.closure(), 5, precision));
+    }
+
+    // A many-sided regular polygon closes without drift.
+    {
+        constexpr auto SIDES = 100000;
+        auto p = Path(Point{-2, 5}, Angle::degrees(-45));
+        auto turn = BasicUnitAngle<T>::degrees(T(360) / SIDES);
+        for (auto i = 0; i < SIDES; ++i) {
+            p.add(turn, 1);
+        }
+        assert(p.closure() < SIDES * 64 * std::numeric_limits<T>::epsilon());
+        assert(fcmp(p.heading(), Angle::degrees(-45), precision - 2));
+    }
+
+    // Closure in bulk, the same for any number of threads.
+    {
+        std::vector<Path> paths;
+        for (auto i = 0; i < 50; ++i) {
+            auto p = Path();
+            p.add(Angle::degrees(T(i)), 3).add(Angle::degrees(90), 4).add(Angle::degrees(90), 3);
+            paths.push_back(p);
+        }
+
+        std::vector<T> closures(paths.size()), parallel(paths.size());
+        Path::closure(paths.data(), paths.size(), closures.data());
+        for (std::size_t i = 0; i < paths.size(); ++i) {
+            assert(closures[i] == paths[i].closure());
+            assert(fcmp(closures[i], 4, precision));
+        }
+        for (std::size_t threads : {1, 3}) {
+            ThreadPool pool(threads);
+            Path::closure(pool, paths.data(), paths.size(), parallel.data(), 7);
+            assert(parallel == closures);
+        }
+    }
+}
+
+} // namespace
+
+int main()
+{
+    test<float>();
+    test<double>();
+    test<long double>();
+}
+
+#endif
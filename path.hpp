@@ -0,0 +1,90 @@
+#pragma once
+
+#include "angle.hpp"
+#include "point.hpp"
+#include "threadpool.hpp"
+#include "unitangle.hpp"
+
+#include <cstddef>
+#include <vector>
+
+/// Models a turtle path: segments that each turn the heading, then move along it, in floating point type @c T.
+/// @see https://en.wikipedia.org/wiki/Turtle_graphics
+/// @discussion The start heading and each turn are converted to their sine and cosine once, when the path is
+/// constructed and when the segment is added. Vertices are then
+/// found in a single pass, rotating the heading by complex multiplication (renormalised at every step) and
+/// accumulating coordinates with compensated (Kahan) summation, so error does not grow with the number of
+/// segments as it does when chaining @c Vector::rotate and @c Vector::translate.
+/// Instantiated for @c float, @c double and @c long double.
+/// @see Path
+template <typename T>
+class BasicPath
+{
+public:
+    using Angle = BasicAngle<T>;
+    using Point = BasicPoint<T>;
+    using UnitAngle = BasicUnitAngle<T>;
+
+    /// Construct an empty path at @c start, heading in @c direction.
+    explicit BasicPath(const Point & start = Point(), const Angle & direction = Angle());
+
+    /// Append a segment turning by @c turn (counter-clockwise), then moving @c length.
+    BasicPath & add(const Angle & turn, T length);
+
+    /// Append a segment turning by @c turn (counter-clockwise), then moving @c length, from the cached sine and
+    /// cosine of @c turn.
+    BasicPath & add(const UnitAngle & turn, T length);
+
+    /// Store the vertices to @c out: the start, then the end of each segment (@c size + 1 points).
+    void vertices(Point * out) const;
+
+    /// @return std::vector<Point> The start, then the end of each segment.
+    std::vector<Point> vertices() const;
+
+    /// @return Point The start.
+    Point start() const;
+
+    /// @return Point The end of the last segment.
+    Point end() const;
+
+    /// @return Angle The heading after the last turn.
+    Angle heading() const;
+
+    /// @return Point The gap from the end back to the start; zero for a closed path.
+    Point gap() const;
+
+    /// @return T Closure error: the length of the gap.
+    T closure() const;
+
+    /// Store the closure errors of @c size @c paths to @c out.
+    static void closure(const BasicPath * paths, std::size_t size, T * out);
+
+    /// Store closure errors as @c closure, in parallel on @c pool in chunks of @c grain paths.
+    static void closure(ThreadPool & pool, const BasicPath * paths, std::size_t size, T * out,
+                        std::size_t grain = ThreadPool::GRAIN);
+
+    /// @return std::size_t Number of segments.
+    std::size_t size() const;
+
+private:
+    /// A segment, with its turn as a unit complex number.
+    struct Segment
+    {
+        T cos;
+        T sin;
+        T length;
+    };
+
+    /// Call @c f with each vertex in turn.
+    template <typename F>
+    void walk(F f) const;
+
+    Point start_;
+    UnitAngle direction_;
+    T turns_;
+    T turnsError_;
+    std::vector<Segment> segments_;
+};
+
+/// Path in double precision.
+using Path = BasicPath<double>;
@@ -1,87 +1,61 @@
 #include "point.hpp"
 
 #include "fcmp.hpp"
+#include "format.hpp"
 
 #include <cmath>
-#include <iomanip>
-#include <sstream>
 
-Point::Point() : x_{}, y_{}
+template <typename T>
+bool BasicPoint<T>::operator==(const BasicPoint & other)
 {
+    return fcmp<3>(x_, other.x_) && fcmp<3>(y_, other.y_);
 }
 
-Point::Point(double x, double y) : x_{x}, y_{y}
-{
-}
-
-double Point::x() const
-{
-    return x_;
-}
-
-double Point::y() const
-{
-    return y_;
-}
-
-bool Point::operator==(const Point & other)
-{
-    return fcmp(x_, other.x_) && fcmp(y_, other.y_);
-}
-
-bool Point::operator!=(const Point & other)
+template <typename T>
+bool BasicPoint<T>::operator!=(const BasicPoint & other)
 {
     return !operator==(other);
 }
 
-Point & Point::operator+=(const Point & other)
-{
-    x_ += other.x_;
-    y_ += other.y_;
-    return *this;
-}
-
-Point & Point::operator-=(const Point & other)
-{
-    x_ -= other.x_;
-    y_ -= other.y_;
-    return *this;
-}
-
-Point Point::operator+(const Point & rhs) const
+template <typename T>
+std::string BasicPoint<T>::description() const
 {
-    Point lhs(*this);
-    lhs += rhs;
-    return lhs;
+    return describe(*this);
 }
 
-Point Point::operator-(const Point & rhs) const
+template <typename T>
+std::size_t BasicPoint<T>::format_to(char * buffer, std::size_t size) const
 {
-    Point lhs(*this);
-    lhs -= rhs;
-    return lhs;
+    return (Format(buffer, size) << "Point (" << x() << ", " << y() << ")").size();
 }
 
-std::string Point::description() const
-{
-    std::stringstream ss;
-    ss << "Point "
-        "(" << x() << ", " << y() << ")";
-    return ss.str();
-}
+template class BasicPoint<float>;
+template class BasicPoint<double>;
+template class BasicPoint<long double>;
 
 #ifdef UNITTEST_POINT
 
 #include <cassert>
+#include <iterator>
 
-int main()
+namespace
 {
-    assert(fcmp(Point().x(), 0));
-    assert(fcmp(Point().y(), 0));
+
+/// Check points in precision @c T.
+template <typename T>
+void test()
+{
+    using Point = BasicPoint<T>;
+
+    static_assert(Point().x() == 0);
+    static_assert(Point().y() == 0);
     assert(Point() == Point(0, 0));
     assert(Point() != Point(1, 1));
-    assert(fcmp(Point(3, 4).x(), 3));
-    assert(fcmp(Point(3, 4).y(), 4));
+    static_assert(Point(3, 4).x() == 3);
+    static_assert(Point(3, 4).y() == 4);
+
+    static_assert((Point(1, 2) += Point(10, 20)).x() == 11);
+    static_assert((Point(10, 20) -= Point(1, 2)).y() == 18);
 
     auto a = Point(1, 2);
     a += Point(10, 20);
@@ -96,7 +70,30 @@ int main()
     assert(a + b == Point(11, 22));
     assert(b - a == Point(9, 18));
 
+    constexpr auto c = Point(1, 2) + Point(10, 20) - Point(2, 4);
+    static_assert(c.x() == 9 && c.y() == 18);
+
     assert(a.description() == std::string("Point (1, 2)"));
+
+    char buffer[8];
+    assert(Point(-0.5, 1e-5).format_to(buffer, sizeof buffer) == 19);
+    assert(std::string(buffer, sizeof buffer) == "Point (-");
+
+    std::string s = "> ";
+    format_to(Point(-0.5, 1e-5), std::back_inserter(s));
+    assert(s == "> Point (-0.5, 1e-05)");
+}
+
+} // namespace
+
+int main()
+{
+    test<float>();
+    test<double>();
+    test<long double>();
+
+    // Descriptions keep the range of the precision.
+    assert(BasicPoint<long double>(1e4000L, -1e-4000L).description() == std::string("Point (1e+4000, -1e-4000)"));
 }
 
 #endif
@@ -1,38 +1,106 @@
 #pragma once
 
+#include <cstddef>
 #include <string>
 
-class Point
+/// Models a point (x,y), in floating point type @c T.
+/// @discussion Instantiated for @c float, @c double and @c long double.
+/// @see Point
+template <typename T>
+class BasicPoint
 {
 public:
     /// Construct an empty point (0,0).
-    Point();
+    constexpr BasicPoint();
 
     /// Construct a point (x,y).
-    Point(double x, double y);
+    constexpr BasicPoint(T x, T y);
 
     /// @return x.
-    double x() const;
+    constexpr T x() const;
 
     /// @return y.
-    double y() const;
+    constexpr T y() const;
 
-    bool operator==(const Point & other);
+    bool operator==(const BasicPoint & other);
 
-    bool operator!=(const Point & other);
+    bool operator!=(const BasicPoint & other);
 
-    Point & operator+=(const Point & other);
+    constexpr BasicPoint & operator+=(const BasicPoint & other);
 
-    Point & operator-=(const Point & other);
+    constexpr BasicPoint & operator-=(const BasicPoint & other);
 
-    Point operator+(const Point & rhs) const;
+    constexpr BasicPoint operator+(const BasicPoint & rhs) const;
 
-    Point operator-(const Point & rhs) const;
+    constexpr BasicPoint operator-(const BasicPoint & rhs) const;
 
     /// @return std::string Description.
     std::string description() const;
 
+    /// Format description into @c buffer of @c size characters, without allocating.
+    /// @discussion Writes at most @c size characters, without a terminator; the output matches @c description.
+    /// @see format_to(const T &, OutputIt) to format to an output iterator.
+    /// @return std::size_t Length of the whole description.
+    std::size_t format_to(char * buffer, std::size_t size) const;
+
 private:
-    double x_;
-    double y_;
+    T x_;
+    T y_;
 };
+
+/// Point in double precision.
+using Point = BasicPoint<double>;
+
+template <typename T>
+constexpr BasicPoint<T>::BasicPoint() : x_{}, y_{}
+{
+}
+
+template <typename T>
+constexpr BasicPoint<T>::BasicPoint(T x, T y) : x_{x}, y_{y}
+{
+}
+
+template <typename T>
+constexpr T BasicPoint<T>::x() const
+{
+    return x_;
+}
+
+template <typename T>
+constexpr T BasicPoint<T>::y() const
+{
+    return y_;
+}
+
+template <typename T>
+constexpr BasicPoint<T> & BasicPoint<T>::operator+=(const BasicPoint & other)
+{
+    x_ += other.x_;
+    y_ += other.y_;
+    return *this;
+}
+
+template <typename T>
+constexpr BasicPoint<T> & BasicPoint<T>::operator-=(const BasicPoint & other)
+{
+    x_ -= other.x_;
+    y_ -= other.y_;
+    return *this;
+}
+
+template <typename T>
+constexpr BasicPoint<T> BasicPoint<T>::operator+(const BasicPoint & rhs) const
+{
+    BasicPoint lhs(*this);
+    lhs += rhs;
+    return lhs;
+}
+
+template <typename T>
+constexpr BasicPoint<T> BasicPoint<T>::operator-(const BasicPoint & rhs) const
+{
+    BasicPoint lhs(*this);
+    lhs -= rhs;
+    return lhs;
+}
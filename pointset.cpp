@@ -0,0 +1,225 @@
+#include "pointset.hpp"
+
+#include "fcmp.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace
+{
+
+/// Largest proportion of occupied slots, as a fraction of 4.
+constexpr std::size_t LOAD = 3;
+
+/// Smallest table.
+constexpr std::size_t MIN_CAPACITY = 16;
+
+} // namespace
+
+PointSet::PointSet() : points_{}, keys_{}, slots_{}, shift_{64}
+{
+}
+
+std::size_t PointSet::size() const
+{
+    return points_.size();
+}
+
+void PointSet::reserve(std::size_t size)
+{
+    points_.reserve(size);
+    keys_.reserve(size);
+
+    auto capacity = std::max(slots_.size(), MIN_CAPACITY);
+    while (size * 4 > capacity * LOAD) {
+        capacity *= 2;
+    }
+    if (capacity != slots_.size()) {
+        rehash(capacity);
+    }
+}
+
+std::pair<std::size_t, bool> PointSet::insert(const Point & point)
+{
+    if ((points_.size() + 1) * 4 > slots_.size() * LOAD) {
+        rehash(std::max(slots_.size() * 2, MIN_CAPACITY));
+    }
+
+    auto k = key(point);
+    auto s = slot(k);
+    if (slots_[s] != npos) {
+        return {slots_[s], false};
+    }
+
+    slots_[s] = points_.size();
+    points_.push_back(point);
+    keys_.push_back(k);
+    return {slots_[s], true};
+}
+
+std::size_t PointSet::find(const Point & point) const
+{
+    if (slots_.empty()) {
+        return npos;
+    }
+    return slots_[slot(key(point))];
+}
+
+bool PointSet::contains(const Point & point) const
+{
+    return find(point) != npos;
+}
+
+const Point & PointSet::operator[](std::size_t index) const
+{
+    return points_[index];
+}
+
+const std::vector<Point> & PointSet::points() const
+{
+    return points_;
+}
+
+PointSet::Key PointSet::key(const Point & point)
+{
+    // Rounded as fcmp<3>; adding zero folds -0 into +0, which compare equal.
+    constexpr auto SCALE = Decimal<3>::SCALE;
+    return {std::round(point.x() * SCALE) + 0., std::round(point.y() * SCALE) + 0.};
+}
+
+std::uint64_t PointSet::hash(const Key & key)
+{
+    std::uint64_t x, y;
+    std::memcpy(&x, &key.x, sizeof x);
+    std::memcpy(&y, &key.y, sizeof y);
+
+    // Mix (after SplitMix64), so the top bits index the table.
+    auto h = x * 0x9e3779b97f4a7c15ull ^ y;
+    h = (h ^ (h >> 30)) * 0xbf58476d1ce4e5b9ull;
+    h = (h ^ (h >> 27)) * 0x94d049bb133111ebull;
+    return h ^ (h >> 31);
+}
+
+std::size_t PointSet::slot(const Key & k) const
+{
+    auto mask = slots_.size() - 1;
+    for (auto s = hash(k) >> shift_;; s = (s + 1) & mask) {
+        auto i = slots_[s];
+        if (i == npos || (keys_[i].x == k.x && keys_[i].y == k.y)) {
+            return s;
+        }
+    }
+}
+
+void PointSet::rehash(std::size_t capacity)
+{
+    slots_.assign(capacity, npos);
+
+    shift_ = 64;
+    for (auto c = capacity; c > 1; c /= 2) {
+        --shift_;
+    }
+
+    auto mask = capacity - 1;
+    for (std::size_t i = 0; i < keys_.size(); ++i) {
+        auto s = hash(keys_[i]) >> shift_;
+        while (slots_[s] != npos) {
+            s = (s + 1) & mask;
+        }
+        slots_[s] = i;
+    }
+}
+
+#ifdef UNITTEST_POINTSET
+
+#include <cassert>
+#include <limits>
+#include <random>
+#include <string>
+
+int main()
+{
+    {
+        PointSet s;
+        assert(s.size() == 0);
+        assert(!s.contains(Point()));
+        assert(s.find(Point()) == PointSet::npos);
+
+        assert(s.insert(Point(1, 2)) == std::make_pair(std::size_t(0), true));
+        assert(s.insert(Point(1.0004, 1.9996)) == std::make_pair(std::size_t(0), false));
+        assert(s.insert(Point(1.0005, 2)) == std::make_pair(std::size_t(1), true));
+        assert(s.contains(Point(0.9996, 2.0004)));
+        assert(s[0].x() == 1 && s[1].x() == 1.0005);
+
+        // Signed zeros are equal.
+        assert(s.insert(Point(-0.0004, 0.)).second);
+        assert(!s.insert(Point(0.0004, -0.)).second);
+
+        // NaN equals nothing, as Point::operator==.
+        auto nan = std::numeric_limits<double>::quiet_NaN();
+        assert(s.insert(Point(nan, 0)).second);
+        assert(s.insert(Point(nan, 0)).second);
+        assert(!s.contains(Point(nan, 0)));
+        assert(s.size() == 5);
+    }
+
+    {
+        // Agrees with pairwise Point::operator==, through growth.
+        std::mt19937_64 random(7);
+        std::uniform_int_distribution<int> grid(-40, 40);
+        std::uniform_real_distribution<double> jitter(-0.0006, 0.0006);
+        std::vector<Point> points;
+        for (auto i = 0; i < 1501; ++i) {
+            points.emplace_back(grid(random) * 0.001 + jitter(random), grid(random) * 0.001 + jitter(random));
+        }
+
+        PointSet s;
+        std::vector<Point> distinct;
+        for (auto & p : points) {
+            auto equal = std::find_if(distinct.begin(), distinct.end(), [&](Point & q) {
+                return q == p;
+            });
+            auto i = s.insert(p);
+            assert(i.second == (equal == distinct.end()));
+            if (i.second) {
+                distinct.push_back(p);
+            } else {
+                assert(Point(s[i.first]) == p);
+            }
+        }
+        assert(s.size() == distinct.size());
+        assert(s.points().size() == distinct.size());
+
+        PointSet r;
+        r.reserve(points.size());
+        r.reserve(10);
+        for (auto & p : points) {
+            r.insert(p);
+        }
+        assert(r.size() == s.size());
+        for (auto & p : points) {
+            assert(r.find(p) == s.find(p));
+        }
+    }
+
+    {
+        PointMap<std::string> m;
+        m.reserve(4);
+        assert(m.insert(Point(1, 1), "a").second);
+        assert(*m.insert(Point(1.0001, 1), "b").first == "a");
+        m[Point(2, 2)] = "c";
+        m[Point(2.0002, 2)] += "d";
+        assert(m.size() == 2);
+        assert(*m.find(Point(2, 2)) == "cd");
+        assert(m.find(Point(3, 3)) == nullptr);
+        assert(m.contains(Point(0.9999, 1)));
+
+        const auto & c = m;
+        assert(*c.find(Point(1, 1)) == "a");
+        assert(c.find(Point(3, 3)) == nullptr);
+        assert(c.points().size() == 2 && c.values()[1] == "cd");
+    }
+}
+
+#endif
@@ -0,0 +1,171 @@
+#pragma once
+
+#include "point.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+/// Models a set of distinct points, equal as @c Point::operator== (to 3 decimal places).
+/// @discussion Points are stored densely, in insertion order, and indexed by an open-addressing hash table
+/// (linear probing) over their rounded coordinates. Rounding is the same as @c Point::operator== applies, so
+/// equality is exact on the rounded grid and no neighbouring cells need probing.
+/// Insert and find are O(1) expected. A NaN coordinate equals nothing, so such points are always inserted.
+class PointSet
+{
+public:
+    /// Index returned by @c find for absent points.
+    static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+    /// Construct an empty set.
+    PointSet();
+
+    /// @return std::size_t Number of points.
+    std::size_t size() const;
+
+    /// Reserve room for @c size points without rehashing.
+    void reserve(std::size_t size);
+
+    /// Insert @c point, unless an equal point is present.
+    /// @return std::pair<std::size_t, bool> Index of the point (or the equal point), and whether it was inserted.
+    std::pair<std::size_t, bool> insert(const Point & point);
+
+    /// @return std::size_t Index of the point equal to @c point, or @c npos.
+    std::size_t find(const Point & point) const;
+
+    /// @return bool Whether a point equal to @c point is present.
+    bool contains(const Point & point) const;
+
+    /// @return Point The point at @c index.
+    const Point & operator[](std::size_t index) const;
+
+    /// @return std::vector<Point> Points, in insertion order.
+    const std::vector<Point> & points() const;
+
+private:
+    /// Coordinates rounded as @c Point::operator== rounds them.
+    struct Key
+    {
+        double x;
+        double y;
+    };
+
+    static Key key(const Point & point);
+
+    static std::uint64_t hash(const Key & key);
+
+    /// @return std::size_t Slot holding the index of @c k, or the empty slot where it belongs.
+    std::size_t slot(const Key & k) const;
+
+    /// Rebuild the table with @c capacity slots (a power of two).
+    void rehash(std::size_t capacity);
+
+    std::vector<Point> points_;
+    std::vector<Key> keys_;
+    std::vector<std::size_t> slots_;
+    unsigned shift_;
+};
+
+/// Models a map from distinct points (as @c PointSet) to values of type @c T.
+template <typename T>
+class PointMap
+{
+public:
+    /// @return std::size_t Number of points.
+    std::size_t size() const;
+
+    /// Reserve room for @c size points without rehashing.
+    void reserve(std::size_t size);
+
+    /// Insert @c value at @c point, unless an equal point is present.
+    /// @return std::pair<T *, bool> The value at the point, and whether it was inserted.
+    std::pair<T *, bool> insert(const Point & point, const T & value);
+
+    /// @return T The value at @c point, inserting a default value if absent.
+    T & operator[](const Point & point);
+
+    /// @return T * The value at @c point, or null.
+    T * find(const Point & point);
+
+    /// @return const T * The value at @c point, or null.
+    const T * find(const Point & point) const;
+
+    /// @return bool Whether a point equal to @c point is present.
+    bool contains(const Point & point) const;
+
+    /// @return std::vector<Point> Points, in insertion order.
+    const std::vector<Point> & points() const;
+
+    /// @return std::vector<T> Values, in the order of @c points.
+    const std::vector<T> & values() const;
+
+private:
+    PointSet points_;
+    std::vector<T> values_;
+};
+
+template <typename T>
+std::size_t PointMap<T>::size() const
+{
+    return points_.size();
+}
+
+template <typename T>
+void PointMap<T>::reserve(std::size_t size)
+{
+    points_.reserve(size);
+    values_.reserve(size);
+}
+
+template <typename T>
+std::pair<T *, bool> PointMap<T>::insert(const Point & point, const T & value)
+{
+    auto i = points_.insert(point);
+    if (i.second) {
+        values_.push_back(value);
+    }
+    return {&values_[i.first], i.second};
+}
+
+template <typename T>
+T & PointMap<T>::operator[](const Point & point)
+{
+    auto i = points_.insert(point);
+    if (i.second) {
+        values_.emplace_back();
+    }
+    return values_[i.first];
+}
+
+template <typename T>
+T * PointMap<T>::find(const Point & point)
+{
+    auto i = points_.find(point);
+    return i == PointSet::npos ? nullptr : &values_[i];
+}
+
+template <typename T>
+const T * PointMap<T>::find(const Point & point) const
+{
+    auto i = points_.find(point);
+    return i == PointSet::npos ? nullptr : &values_[i];
+}
+
+template <typename T>
+bool PointMap<T>::contains(const Point & point) const
+{
+    return points_.contains(point);
+}
+
+template <typename T>
+const std::vector<Point> & PointMap<T>::points() const
+{
+    return points_.points();
+}
+
+template <typename T>
+const std::vector<T> & PointMap<T>::values() const
+{
+    return values_;
+}
@@ -1,116 +1,167 @@
 #include "rightangledtriangle.hpp"
 
-#include <cmath>
-#include <sstream>
+#include "format.hpp"
+#include "instrument.hpp"
 
-namespace
-{
-
-/// @return @c x squared.
-inline double sqr(double x)
+template <typename T>
+BasicRightAngledTriangle<T>::BasicRightAngledTriangle(T a, T b, T c, const Angle & A) :
+    A_{A}, a_{a}, b_{b}, c_{c}
 {
-    return pow(x, 2);
+    TRIG_COUNT(RIGHT_ANGLED_TRIANGLE);
 }
 
-} // namespace
-
-RightAngledTriangle RightAngledTriangle::with_A_c(const Angle & A, double c)
+template <typename T>
+BasicRightAngledTriangle<T> BasicRightAngledTriangle<T>::scaled(const BasicRightAngledTriangle & r, T k)
 {
-    auto a = sin(A) * c;
-    return with_a_c(a, c);
+    return BasicRightAngledTriangle(r.a_ * k, r.b_ * k, r.c_ * k, r.A_);
 }
 
-RightAngledTriangle RightAngledTriangle::with_a_b(double a, double b)
+template <typename T>
+BasicRightAngledTriangle<T> BasicRightAngledTriangle<T>::similar_a(const BasicRightAngledTriangle & r, T a)
 {
-    auto a2 = sqr(a);
-    auto b2 = sqr(b);
-    auto c = sqrt(a2 + b2);
-    return RightAngledTriangle(a, b, c);
+    auto k = a / r.a_;
+    return BasicRightAngledTriangle(a, r.b_ * k, r.c_ * k, r.A_);
 }
 
-RightAngledTriangle RightAngledTriangle::with_a_c(double a, double c)
+template <typename T>
+BasicRightAngledTriangle<T> BasicRightAngledTriangle<T>::similar_b(const BasicRightAngledTriangle & r, T b)
 {
-    auto a2 = sqr(a);
-    auto c2 = sqr(c);
-    auto b = sqrt(c2 - a2);
-    return RightAngledTriangle(a, b, c);
+    auto k = b / r.b_;
+    return BasicRightAngledTriangle(r.a_ * k, b, r.c_ * k, r.A_);
 }
 
-RightAngledTriangle RightAngledTriangle::with_a(const RightAngledTriangle & r, double a)
+template <typename T>
+BasicRightAngledTriangle<T> BasicRightAngledTriangle<T>::similar_c(const BasicRightAngledTriangle & r, T c)
 {
-    auto b = a / tan(r.A());
-    auto c = b / cos(r.A());
-    return RightAngledTriangle(a, b, c);
+    auto k = c / r.c_;
+    return BasicRightAngledTriangle(r.a_ * k, r.b_ * k, c, r.A_);
 }
 
-RightAngledTriangle RightAngledTriangle::with_b(const RightAngledTriangle & r, double b)
+template <typename T>
+void BasicRightAngledTriangle<T>::similar_a(const BasicRightAngledTriangle & r, const T * a, std::size_t size,
+                                             BasicRightAngledTriangle * out)
 {
-    auto a = tan(r.A()) * b;
-    auto c = b / cos(r.A());
-    return RightAngledTriangle(a, b, c);
+    auto b = r.b_ / r.a_;
+    auto c = r.c_ / r.a_;
+    for (std::size_t i = 0; i < size; ++i) {
+        out[i] = BasicRightAngledTriangle(a[i], a[i] * b, a[i] * c, r.A_);
+    }
 }
 
-RightAngledTriangle RightAngledTriangle::with_c(const RightAngledTriangle & r, double c)
+template <typename T>
+void BasicRightAngledTriangle<T>::similar_b(const BasicRightAngledTriangle & r, const T * b, std::size_t size,
+                                             BasicRightAngledTriangle * out)
 {
-    auto a = sin(r.A()) * c;
-    auto b = cos(r.A()) * c;
-    return RightAngledTriangle(a, b, c);
+    auto a = r.a_ / r.b_;
+    auto c = r.c_ / r.b_;
+    for (std::size_t i = 0; i < size; ++i) {
+        out[i] = BasicRightAngledTriangle(b[i] * a, b[i], b[i] * c, r.A_);
+    }
 }
 
-RightAngledTriangle::RightAngledTriangle(double a, double b, double c) : a_{a}, b_{b}, c_{c}
+template <typename T>
+void BasicRightAngledTriangle<T>::similar_c(const BasicRightAngledTriangle & r, const T * c, std::size_t size,
+                                             BasicRightAngledTriangle * out)
 {
-    A_ = Angle::radians(atan(a / b));
+    auto a = r.a_ / r.c_;
+    auto b = r.b_ / r.c_;
+    for (std::size_t i = 0; i < size; ++i) {
+        out[i] = BasicRightAngledTriangle(c[i] * a, c[i] * b, c[i], r.A_);
+    }
 }
 
-Angle RightAngledTriangle::A() const
+template <typename T>
+std::string BasicRightAngledTriangle<T>::description() const
 {
-    return A_;
+    return describe(*this);
 }
 
-Angle RightAngledTriangle::B() const
+template <typename T>
+std::size_t BasicRightAngledTriangle<T>::format_to(char * buffer, std::size_t size) const
 {
-    auto C_ = M_PI_2;
-    return Angle::radians(M_PI - C_ - A());
+    auto B = this->B();
+    return (Format(buffer, size) << "RightAngledTriangle "
+        << a() << ", " << b() << ", " << c() << "; "
+        << A() << " (" << A().deg() << "°), "
+        << B << " (" << B.deg() << "°)").size();
 }
 
-double RightAngledTriangle::a() const
-{
-    return a_;
-}
+template class BasicRightAngledTriangle<float>;
+template class BasicRightAngledTriangle<double>;
+template class BasicRightAngledTriangle<long double>;
+
+#ifdef UNITTEST_RIGHTANGLEDTRIANGLE
+
+#include "fcmp.hpp"
 
-double RightAngledTriangle::b() const
+#include <algorithm>
+#include <cassert>
+#include <limits>
+#include <vector>
+
+namespace
 {
-    return b_;
-}
 
-double RightAngledTriangle::c() const
+/// @return bool Whether @c t matches @c u within relative @c tolerance.
+template <typename T>
+bool near(const BasicRightAngledTriangle<T> & t, const BasicRightAngledTriangle<T> & u, double tolerance)
 {
-    return c_;
+    return std::fabs(t.A().rad() - u.A().rad()) <= tolerance * u.A().rad()
+        && std::fabs(t.a() - u.a()) <= tolerance * u.a()
+        && std::fabs(t.b() - u.b()) <= tolerance * u.b()
+        && std::fabs(t.c() - u.c()) <= tolerance * u.c();
 }
 
-std::string RightAngledTriangle::description() const
+/// Solve in precision @c T with trigonometry policy @c Trig, within relative @c tolerance of libm.
+/// @discussion Policies other than libm evaluate in double, so agree with libm only to the precision of @c T.
+template <typename T, typename Trig>
+void check(double tolerance)
 {
-    std::stringstream ss;
-    ss << "RightAngledTriangle "
-        << a() << ", " << b() << ", " << c() << "; "
-        << A() << " (" << A().deg() << "°), "
-        << B() << " (" << B().deg() << "°)";
-    return ss.str();
-}
+    using Angle = BasicAngle<T>;
+    using RightAngledTriangle = BasicRightAngledTriangle<T>;
+    using Libm = trig::Libm;
 
-#ifdef UNITTEST_RIGHTANGLEDTRIANGLE
+    if (!std::is_same_v<Trig, Libm>) {
+        tolerance = std::max(tolerance, 16. * static_cast<double>(std::numeric_limits<T>::epsilon()));
+    }
 
-#include "fcmp.hpp"
+    auto t = RightAngledTriangle::template with_a_b<Trig>(3, 4);
+    auto u = RightAngledTriangle::template with_a_b<Libm>(3, 4);
+    assert(near(t, u, tolerance));
 
-#include <cassert>
+    t = RightAngledTriangle::template with_a_c<Trig>(6, 10);
+    u = RightAngledTriangle::template with_a_c<Libm>(6, 10);
+    assert(near(t, u, tolerance));
 
-int main()
+    t = RightAngledTriangle::template with_A_c<Trig>(Angle::degrees(36.87), 5);
+    u = RightAngledTriangle::template with_A_c<Libm>(Angle::degrees(36.87), 5);
+    assert(near(t, u, tolerance));
+
+    t = RightAngledTriangle::template with_a<Trig>(u, 30);
+    u = RightAngledTriangle::template with_a<Libm>(u, 30);
+    assert(near(t, u, tolerance));
+
+    t = RightAngledTriangle::template with_b<Trig>(u, 80);
+    u = RightAngledTriangle::template with_b<Libm>(u, 80);
+    assert(near(t, u, tolerance));
+
+    t = RightAngledTriangle::template with_c<Trig>(u, 10);
+    u = RightAngledTriangle::template with_c<Libm>(u, 10);
+    assert(near(t, u, tolerance));
+}
+
+/// Check right-angled triangles in precision @c T.
+template <typename T>
+void test()
 {
-    auto t = RightAngledTriangle::with_a_b(1, sqrt(3));
+    using Angle = BasicAngle<T>;
+    using RightAngledTriangle = BasicRightAngledTriangle<T>;
+
+    auto t = RightAngledTriangle::with_a_b(1, std::sqrt(T(3)));
     assert(fcmp(t.A(), Angle::degrees(30)));
     assert(fcmp(t.B(), Angle::degrees(60)));
     assert(fcmp(t.a(), 1));
-    assert(fcmp(t.b(), sqrt(3)));
+    assert(fcmp(t.b(), std::sqrt(T(3))));
     assert(fcmp(t.c(), 2));
 
     t = RightAngledTriangle::with_a_b(3, 4);
@@ -120,8 +171,6 @@ int main()
     assert(fcmp(t.b(), 4));
     assert(fcmp(t.c(), 5));
 
-    assert(RightAngledTriangle::with_a_b(3, 4).description() == "RightAngledTriangle 3, 4, 5; 0.643501 (36.8699°), 0.927295 (53.1301°)");
-
     t = RightAngledTriangle::with_a_c(6, 10);
     assert(fcmp(t.a(), 6));
     assert(fcmp(t.b(), 8));
@@ -132,6 +181,13 @@ int main()
     assert(fcmp(t.b(), 4));
     assert(fcmp(t.c(), 5));
 
+    auto A = BasicUnitAngle<T>::degrees(36.87);
+    t = RightAngledTriangle::with_A_c(A, 5);
+    assert(t.A() == A.angle());
+    assert(fcmp(t.a(), 3));
+    assert(fcmp(t.b(), 4));
+    assert(fcmp(t.c(), 5));
+
     t = RightAngledTriangle::with_a(t, 30);
     assert(fcmp(t.a(), 30));
     assert(fcmp(t.b(), 40));
@@ -146,6 +202,62 @@ int main()
     assert(fcmp(t.a(), 6));
     assert(fcmp(t.b(), 8));
     assert(fcmp(t.c(), 10));
+
+    // Similar triangles scale the sides, and keep A exactly.
+    auto r = RightAngledTriangle::with_a_b(3, 4);
+    t = RightAngledTriangle::scaled(r, 10);
+    assert(t.A() == r.A());
+    assert(fcmp(t.a(), 30));
+    assert(fcmp(t.b(), 40));
+    assert(fcmp(t.c(), 50));
+
+    for (auto & s : {RightAngledTriangle::similar_a(r, 6),
+                     RightAngledTriangle::similar_b(r, 8),
+                     RightAngledTriangle::similar_c(r, 10)}) {
+        assert(s.A() == r.A());
+        assert(fcmp(s.a(), 6));
+        assert(fcmp(s.b(), 8));
+        assert(fcmp(s.c(), 10));
+    }
+    assert(RightAngledTriangle::similar_a(r, 6).a() == 6);
+    assert(RightAngledTriangle::similar_b(r, 8).b() == 8);
+    assert(RightAngledTriangle::similar_c(r, 10).c() == 10);
+
+    // A family of similar triangles matches each built alone, to rounding.
+    {
+        std::vector<T> sides = {0.5, 1, 2.5, 10, 1000};
+        std::vector<RightAngledTriangle> as(sides.size(), r), bs(as), cs(as);
+        RightAngledTriangle::similar_a(r, sides.data(), sides.size(), as.data());
+        RightAngledTriangle::similar_b(r, sides.data(), sides.size(), bs.data());
+        RightAngledTriangle::similar_c(r, sides.data(), sides.size(), cs.data());
+        for (std::size_t i = 0; i < sides.size(); ++i) {
+            auto a = RightAngledTriangle::similar_a(r, sides[i]);
+            auto b = RightAngledTriangle::similar_b(r, sides[i]);
+            auto c = RightAngledTriangle::similar_c(r, sides[i]);
+            assert(as[i].A() == r.A() && as[i].a() == a.a() && fcmp(as[i].b(), a.b()) && fcmp(as[i].c(), a.c()));
+            assert(bs[i].A() == r.A() && bs[i].b() == b.b() && fcmp(bs[i].a(), b.a()) && fcmp(bs[i].c(), b.c()));
+            assert(cs[i].A() == r.A() && cs[i].c() == c.c() && fcmp(cs[i].a(), c.a()) && fcmp(cs[i].b(), c.b()));
+            assert(fcmp(cs[i].a(), sides[i] * 3 / 5));
+        }
+    }
+
+    assert(RightAngledTriangle::with_a_b(3, 4).description() == "RightAngledTriangle 3, 4, 5; 0.643501 (36.8699°), 0.927295 (53.1301°)");
+
+    check<T, trig::Libm>(0.);
+    check<T, trig::Minimax<3>>(1e-4);
+    check<T, trig::Minimax<4>>(1e-6);
+    check<T, trig::Minimax<5>>(1e-7);
+    check<T, trig::Table<256>>(1e-10);
+    check<T, trig::Table<4096>>(1e-13);
+}
+
+} // namespace
+
+int main()
+{
+    test<float>();
+    test<double>();
+    test<long double>();
 }
 
 #endif
@@ -1,12 +1,17 @@
 #pragma once
 
 #include "angle.hpp"
+#include "trig.hpp"
+#include "unitangle.hpp"
 
+#include <cmath>
+#include <cstddef>
 #include <string>
 
 /// Models a right-angled triangle.
 /// @discussion The triangle is comprised of opposite side @c a, adjacent side @c b, and hypotenuse @c c.
 /// Angle @c C (opposite side @c) is 90 degrees by definition.
+/// Factories take a trigonometry policy (@see trig.hpp), defaulting to libm.
 /// ```
 ///   +
 ///   |\     .
@@ -17,52 +22,201 @@
 ///   +-----+
 ///      b
 /// ```
-class RightAngledTriangle
+/// Instantiated for @c float, @c double and @c long double.
+/// @see RightAngledTriangle
+template <typename T>
+class BasicRightAngledTriangle
 {
 public:
+    using Angle = BasicAngle<T>;
+    using UnitAngle = BasicUnitAngle<T>;
+
     /// Construct right-angled triangle with sides @c a and @c b.
-    static RightAngledTriangle with_a_b(double a, double b);
+    template <typename Trig = trig::Libm>
+    static BasicRightAngledTriangle with_a_b(T a, T b);
 
     /// Construct right-angled triangle with sides @c a and @c c.
-    static RightAngledTriangle with_a_c(double a, double c);
+    template <typename Trig = trig::Libm>
+    static BasicRightAngledTriangle with_a_c(T a, T c);
 
     /// Construct right-angled triangle with angle @c A and hypotenuse @c c.
-    static RightAngledTriangle with_A_c(const Angle & A, double c);
+    template <typename Trig = trig::Libm>
+    static BasicRightAngledTriangle with_A_c(const Angle & A, T c);
+
+    /// Construct right-angled triangle with angle @c A and hypotenuse @c c, from the cached sine and cosine of @c A.
+    /// @discussion Makes no trigonometric calls, and keeps @c A exactly.
+    static BasicRightAngledTriangle with_A_c(const UnitAngle & A, T c);
 
     /// Construct right-angled triangle from existing triangle @c r, with new opposite side @c a.
-    static RightAngledTriangle with_a(const RightAngledTriangle &, double a);
+    /// @see similar_a to scale without trigonometry.
+    template <typename Trig = trig::Libm>
+    static BasicRightAngledTriangle with_a(const BasicRightAngledTriangle &, T a);
 
     /// Construct right-angled triangle from existing triangle @c r, with new adjacent side @c b.
-    static RightAngledTriangle with_b(const RightAngledTriangle &, double b);
+    /// @see similar_b to scale without trigonometry.
+    template <typename Trig = trig::Libm>
+    static BasicRightAngledTriangle with_b(const BasicRightAngledTriangle &, T b);
 
     /// Construct right-angled triangle from existing triangle @c r, with new hypotenuse @c c.
-    static RightAngledTriangle with_c(const RightAngledTriangle &, double c);
+    /// @see similar_c to scale without trigonometry.
+    template <typename Trig = trig::Libm>
+    static BasicRightAngledTriangle with_c(const BasicRightAngledTriangle &, T c);
+
+    /// Construct right-angled triangle similar to @c r, with its sides scaled by @c k.
+    /// @discussion Makes no trigonometric calls, and keeps @c A exactly.
+    static BasicRightAngledTriangle scaled(const BasicRightAngledTriangle & r, T k);
+
+    /// Construct right-angled triangle similar to @c r, with new opposite side @c a.
+    /// @discussion Scales the other sides of @c r by the single factor @c a / @c r.a(), so makes no trigonometric
+    /// calls, and keeps @c A exactly. Side @c a of @c r must be non-zero.
+    static BasicRightAngledTriangle similar_a(const BasicRightAngledTriangle & r, T a);
+
+    /// Construct right-angled triangle similar to @c r, with new adjacent side @c b.
+    /// @see similar_a
+    static BasicRightAngledTriangle similar_b(const BasicRightAngledTriangle & r, T b);
+
+    /// Construct right-angled triangle similar to @c r, with new hypotenuse @c c.
+    /// @see similar_a
+    static BasicRightAngledTriangle similar_c(const BasicRightAngledTriangle & r, T c);
+
+    /// Store the triangles similar to @c r with the @c size opposite sides @c a, to @c out.
+    /// @discussion The ratios of the sides of @c r are found once, so each triangle costs two multiplications.
+    /// Each matches @c similar_a to rounding, and keeps @c a and @c A exactly.
+    static void similar_a(const BasicRightAngledTriangle & r, const T * a, std::size_t size,
+                          BasicRightAngledTriangle * out);
+
+    /// Store the triangles similar to @c r with the @c size adjacent sides @c b, to @c out.
+    /// @see similar_a
+    static void similar_b(const BasicRightAngledTriangle & r, const T * b, std::size_t size,
+                          BasicRightAngledTriangle * out);
+
+    /// Store the triangles similar to @c r with the @c size hypotenuses @c c, to @c out.
+    /// @see similar_a
+    static void similar_c(const BasicRightAngledTriangle & r, const T * c, std::size_t size,
+                          BasicRightAngledTriangle * out);
 
     /// @return double Angle @c A (which is opposite side @c a).
-    Angle A() const;
+    constexpr Angle A() const;
 
     /// @return double Angle @c B (which is opposite side @c b).
-    Angle B() const;
+    constexpr Angle B() const;
 
-    /// @return double Length of opposite side @c a.
-    double a() const;
+    /// @return T Length of opposite side @c a.
+    constexpr T a() const;
 
-    /// @return double Length of adjacent side @c b.
-    double b() const;
+    /// @return T Length of adjacent side @c b.
+    constexpr T b() const;
 
-    /// @return double Length of hypotenuse @c c.
-    double c() const;
+    /// @return T Length of hypotenuse @c c.
+    constexpr T c() const;
 
     /// @return std::string Description.
     std::string description() const;
 
+    /// Format description into @c buffer of @c size characters, without allocating.
+    /// @discussion Writes at most @c size characters, without a terminator; the output matches @c description.
+    /// @see format_to(const T &, OutputIt) to format to an output iterator.
+    /// @return std::size_t Length of the whole description.
+    std::size_t format_to(char * buffer, std::size_t size) const;
+
 private:
     /// Private constructor.
     /// @discussion Factory methods are used to create instances of right-angled triangle.
-    RightAngledTriangle(double a, double b, double c);
+    BasicRightAngledTriangle(T a, T b, T c, const Angle & A);
 
     Angle A_;
-    double a_;
-    double b_;
-    double c_;
+    T a_;
+    T b_;
+    T c_;
 };
+
+/// Right-angled triangle in double precision.
+using RightAngledTriangle = BasicRightAngledTriangle<double>;
+
+template <typename T>
+constexpr BasicAngle<T> BasicRightAngledTriangle<T>::A() const
+{
+    return A_;
+}
+
+template <typename T>
+constexpr BasicAngle<T> BasicRightAngledTriangle<T>::B() const
+{
+    auto C_ = PI_2<T>;
+    return Angle::radians(PI<T> - C_ - A());
+}
+
+template <typename T>
+constexpr T BasicRightAngledTriangle<T>::a() const
+{
+    return a_;
+}
+
+template <typename T>
+constexpr T BasicRightAngledTriangle<T>::b() const
+{
+    return b_;
+}
+
+template <typename T>
+constexpr T BasicRightAngledTriangle<T>::c() const
+{
+    return c_;
+}
+
+template <typename T>
+template <typename Trig>
+BasicRightAngledTriangle<T> BasicRightAngledTriangle<T>::with_a_b(T a, T b)
+{
+    auto c = std::sqrt(a * a + b * b);
+    return BasicRightAngledTriangle(a, b, c, Angle::radians(Trig::atan(a / b)));
+}
+
+template <typename T>
+template <typename Trig>
+BasicRightAngledTriangle<T> BasicRightAngledTriangle<T>::with_a_c(T a, T c)
+{
+    auto b = std::sqrt(c * c - a * a);
+    return BasicRightAngledTriangle(a, b, c, Angle::radians(Trig::atan(a / b)));
+}
+
+template <typename T>
+template <typename Trig>
+BasicRightAngledTriangle<T> BasicRightAngledTriangle<T>::with_A_c(const Angle & A, T c)
+{
+    auto a = Trig::sin(A) * c;
+    return with_a_c<Trig>(a, c);
+}
+
+template <typename T>
+BasicRightAngledTriangle<T> BasicRightAngledTriangle<T>::with_A_c(const UnitAngle & A, T c)
+{
+    return BasicRightAngledTriangle(A.sin() * c, A.cos() * c, c, A.angle());
+}
+
+template <typename T>
+template <typename Trig>
+BasicRightAngledTriangle<T> BasicRightAngledTriangle<T>::with_a(const BasicRightAngledTriangle & r, T a)
+{
+    auto b = a / Trig::tan(r.A());
+    auto c = b / Trig::cos(r.A());
+    return BasicRightAngledTriangle(a, b, c, Angle::radians(Trig::atan(a / b)));
+}
+
+template <typename T>
+template <typename Trig>
+BasicRightAngledTriangle<T> BasicRightAngledTriangle<T>::with_b(const BasicRightAngledTriangle & r, T b)
+{
+    auto a = Trig::tan(r.A()) * b;
+    auto c = b / Trig::cos(r.A());
+    return BasicRightAngledTriangle(a, b, c, Angle::radians(Trig::atan(a / b)));
+}
+
+template <typename T>
+template <typename Trig>
+BasicRightAngledTriangle<T> BasicRightAngledTriangle<T>::with_c(const BasicRightAngledTriangle & r, T c)
+{
+    auto a = Trig::sin(r.A()) * c;
+    auto b = Trig::cos(r.A()) * c;
+    return BasicRightAngledTriangle(a, b, c, Angle::radians(Trig::atan(a / b)));
+}
@@ -0,0 +1,389 @@
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#endif
+
+/// Portable packs of doubles and branchless kernels written against them.
+/// @discussion Kernels are templates, instantiated for @c Pack (SIMD lanes) and @c double (scalar tail),
+/// so the vector and scalar paths compute bit-identical results.
+/// AVX provides four lanes, SSE2 two; other targets fall back to one.
+namespace simd
+{
+
+#if defined(__AVX__)
+
+struct Mask
+{
+    __m256d v;
+};
+
+struct Pack
+{
+    static constexpr std::size_t width = 4;
+
+    Pack(double x) : v{_mm256_set1_pd(x)} {}
+    explicit Pack(__m256d x) : v{x} {}
+
+    static Pack load(const double * p) { return Pack{_mm256_loadu_pd(p)}; }
+    void store(double * p) const { _mm256_storeu_pd(p, v); }
+
+    __m256d v;
+};
+
+inline Pack operator+(Pack a, Pack b) { return Pack{_mm256_add_pd(a.v, b.v)}; }
+inline Pack operator-(Pack a, Pack b) { return Pack{_mm256_sub_pd(a.v, b.v)}; }
+inline Pack operator*(Pack a, Pack b) { return Pack{_mm256_mul_pd(a.v, b.v)}; }
+inline Pack operator/(Pack a, Pack b) { return Pack{_mm256_div_pd(a.v, b.v)}; }
+inline Pack operator-(Pack a) { return Pack{_mm256_xor_pd(a.v, _mm256_set1_pd(-0.0))}; }
+
+inline Mask operator< (Pack a, Pack b) { return Mask{_mm256_cmp_pd(a.v, b.v, _CMP_LT_OQ)}; }
+inline Mask operator<=(Pack a, Pack b) { return Mask{_mm256_cmp_pd(a.v, b.v, _CMP_LE_OQ)}; }
+inline Mask operator> (Pack a, Pack b) { return Mask{_mm256_cmp_pd(a.v, b.v, _CMP_GT_OQ)}; }
+inline Mask operator>=(Pack a, Pack b) { return Mask{_mm256_cmp_pd(a.v, b.v, _CMP_GE_OQ)}; }
+inline Mask operator==(Pack a, Pack b) { return Mask{_mm256_cmp_pd(a.v, b.v, _CMP_EQ_OQ)}; }
+
+inline Mask operator&(Mask a, Mask b) { return Mask{_mm256_and_pd(a.v, b.v)}; }
+inline Mask operator|(Mask a, Mask b) { return Mask{_mm256_or_pd(a.v, b.v)}; }
+
+/// @return int Lanes of @c m set, as bits.
+inline int bits(Mask m) { return _mm256_movemask_pd(m.v); }
+
+/// @return Lanes of @c a where @c m is set, otherwise lanes of @c b.
+inline Pack select(Mask m, Pack a, Pack b) { return Pack{_mm256_blendv_pd(b.v, a.v, m.v)}; }
+
+inline Pack abs(Pack a) { return Pack{_mm256_andnot_pd(_mm256_set1_pd(-0.0), a.v)}; }
+inline Pack sqrt(Pack a) { return Pack{_mm256_sqrt_pd(a.v)}; }
+
+#elif defined(__SSE2__) || defined(_M_X64)
+
+struct Mask
+{
+    __m128d v;
+};
+
+struct Pack
+{
+    static constexpr std::size_t width = 2;
+
+    Pack(double x) : v{_mm_set1_pd(x)} {}
+    explicit Pack(__m128d x) : v{x} {}
+
+    static Pack load(const double * p) { return Pack{_mm_loadu_pd(p)}; }
+    void store(double * p) const { _mm_storeu_pd(p, v); }
+
+    __m128d v;
+};
+
+inline Pack operator+(Pack a, Pack b) { return Pack{_mm_add_pd(a.v, b.v)}; }
+inline Pack operator-(Pack a, Pack b) { return Pack{_mm_sub_pd(a.v, b.v)}; }
+inline Pack operator*(Pack a, Pack b) { return Pack{_mm_mul_pd(a.v, b.v)}; }
+inline Pack operator/(Pack a, Pack b) { return Pack{_mm_div_pd(a.v, b.v)}; }
+inline Pack operator-(Pack a) { return Pack{_mm_xor_pd(a.v, _mm_set1_pd(-0.0))}; }
+
+inline Mask operator< (Pack a, Pack b) { return Mask{_mm_cmplt_pd(a.v, b.v)}; }
+inline Mask operator<=(Pack a, Pack b) { return Mask{_mm_cmple_pd(a.v, b.v)}; }
+inline Mask operator> (Pack a, Pack b) { return Mask{_mm_cmpgt_pd(a.v, b.v)}; }
+inline Mask operator>=(Pack a, Pack b) { return Mask{_mm_cmpge_pd(a.v, b.v)}; }
+inline Mask operator==(Pack a, Pack b) { return Mask{_mm_cmpeq_pd(a.v, b.v)}; }
+
+inline Mask operator&(Mask a, Mask b) { return Mask{_mm_and_pd(a.v, b.v)}; }
+inline Mask operator|(Mask a, Mask b) { return Mask{_mm_or_pd(a.v, b.v)}; }
+
+/// @return int Lanes of @c m set, as bits.
+inline int bits(Mask m) { return _mm_movemask_pd(m.v); }
+
+/// @return Lanes of @c a where @c m is set, otherwise lanes of @c b.
+inline Pack select(Mask m, Pack a, Pack b) { return Pack{_mm_or_pd(_mm_and_pd(m.v, a.v), _mm_andnot_pd(m.v, b.v))}; }
+
+inline Pack abs(Pack a) { return Pack{_mm_andnot_pd(_mm_set1_pd(-0.0), a.v)}; }
+inline Pack sqrt(Pack a) { return Pack{_mm_sqrt_pd(a.v)}; }
+
+#else
+
+struct Mask
+{
+    bool v;
+};
+
+struct Pack
+{
+    static constexpr std::size_t width = 1;
+
+    Pack(double x) : v{x} {}
+
+    static Pack load(const double * p) { return Pack{*p}; }
+    void store(double * p) const { *p = v; }
+
+    double v;
+};
+
+inline Pack operator+(Pack a, Pack b) { return Pack{a.v + b.v}; }
+inline Pack operator-(Pack a, Pack b) { return Pack{a.v - b.v}; }
+inline Pack operator*(Pack a, Pack b) { return Pack{a.v * b.v}; }
+inline Pack operator/(Pack a, Pack b) { return Pack{a.v / b.v}; }
+inline Pack operator-(Pack a) { return Pack{-a.v}; }
+
+inline Mask operator< (Pack a, Pack b) { return Mask{a.v <  b.v}; }
+inline Mask operator<=(Pack a, Pack b) { return Mask{a.v <= b.v}; }
+inline Mask operator> (Pack a, Pack b) { return Mask{a.v >  b.v}; }
+inline Mask operator>=(Pack a, Pack b) { return Mask{a.v >= b.v}; }
+inline Mask operator==(Pack a, Pack b) { return Mask{a.v == b.v}; }
+
+inline Mask operator&(Mask a, Mask b) { return Mask{a.v && b.v}; }
+inline Mask operator|(Mask a, Mask b) { return Mask{a.v || b.v}; }
+
+/// @return int Lanes of @c m set, as bits.
+inline int bits(Mask m) { return m.v; }
+
+/// @return @c a if @c m is set, otherwise @c b.
+inline Pack select(Mask m, Pack a, Pack b) { return m.v ? a : b; }
+
+inline Pack abs(Pack a) { return Pack{std::fabs(a.v)}; }
+inline Pack sqrt(Pack a) { return Pack{std::sqrt(a.v)}; }
+
+#endif
+
+/// @return @c a if @c m is set, otherwise @c b.
+inline double select(bool m, double a, double b) { return m ? a : b; }
+
+/// @return int Whether @c m is set, as a bit.
+inline int bits(bool m) { return m; }
+
+inline double abs(double a) { return std::fabs(a); }
+inline double sqrt(double a) { return std::sqrt(a); }
+
+/// @return The value (or pack of values) at @c p.
+template <typename T>
+T load(const double * p);
+
+template <>
+inline double load<double>(const double * p) { return *p; }
+
+template <>
+inline Pack load<Pack>(const double * p) { return Pack::load(p); }
+
+/// Store @c v to @c p.
+inline void store(double * p, double v) { *p = v; }
+inline void store(double * p, Pack v) { v.store(p); }
+
+/// Store lanes of @c m to @c p.
+inline void store(bool * p, bool m) { *p = m; }
+inline void store(bool * p, Mask m)
+{
+    auto b = bits(m);
+    for (std::size_t k = 0; k < Pack::width; ++k) {
+        p[k] = (b >> k) & 1;
+    }
+}
+
+/// Invoke @c f(i, t) for indices @c i in the range 0..size, a pack at a time.
+/// @discussion The type of @c t is @c Pack for whole packs and @c double for the scalar tail.
+template <typename F>
+void for_each(std::size_t size, F f)
+{
+    std::size_t i = 0;
+    for (; i + Pack::width <= size; i += Pack::width) {
+        f(i, Pack(0.));
+    }
+    for (; i < size; ++i) {
+        f(i, 0.);
+    }
+}
+
+/// Apply @c f to @c size elements of @c in, storing to @c out.
+template <typename F>
+void transform(const double * in, double * out, std::size_t size, F f)
+{
+    for_each(size, [&](std::size_t i, auto t) {
+        store(out + i, f(load<decltype(t)>(in + i)));
+    });
+}
+
+/// @return @c x rounded to the nearest integer (ties to even).
+/// @discussion Valid for |x| < 2^51.
+template <typename T>
+T nearest(T x)
+{
+    constexpr double MAGIC = 0x1.8p+52;
+    return (x + MAGIC) - MAGIC;
+}
+
+/// @return @c x rounded to the nearest integer (ties away from zero), as @c std::round.
+template <typename T>
+T round(T x)
+{
+    // Every double of magnitude 2^52 or more is an integer.
+    constexpr double TWO52 = 0x1p+52;
+    auto a = abs(x);
+    auto n = (a + TWO52) - TWO52;
+    n = select(n - a == -0.5, n + 1., n);
+    n = select(a < TWO52, n, a);
+    return select(x < 0., -n, n);
+}
+
+/// @return Largest integer not greater than @c x.
+/// @discussion Valid for |x| < 2^51.
+template <typename T>
+T floor(T x)
+{
+    auto n = nearest(x);
+    return n - select(n > x, T(1), T(0));
+}
+
+/// Largest magnitude accepted by the range-reducing kernels (2^20 turns).
+constexpr double REDUCE_LIMIT = 0x1p+20 * 6.283185307179586;
+
+/// @return Radians @c x reduced to the range 0..2π.
+/// @discussion Inputs already in range are returned unchanged, matching @c Angle.
+/// Valid for |x| < @c REDUCE_LIMIT.
+template <typename T>
+T scale(T x)
+{
+    // 2π split into 33-bit parts, so that k·2πᵢ is exact for |k| < 2^20.
+    constexpr double TWOPI   =  0x1.921fb54442d18p+2;
+    constexpr double TWOPI_BELOW = 0x1.921fb54442d17p+2;
+    constexpr double TWOPI_1 =  0x1.921fb544p+2;
+    constexpr double TWOPI_2 =  0x1.0b4611a6p-32;
+    constexpr double TWOPI_3 =  0x1.3198a2e037073p-67;
+    constexpr double INV_TWOPI = 0x1.45f306dc9c883p-3;
+
+    auto k = nearest(x * INV_TWOPI);
+    auto r = ((x - k * TWOPI_1) - k * TWOPI_2) - k * TWOPI_3;
+    r = select(r < 0., r + TWOPI, r);
+    r = select(r >= TWOPI, r - TWOPI, r);
+    // A whole turn that rounded to one ulp below 2π is 0, as in @c Angle.
+    r = select(r == TWOPI_BELOW, T(0.), r);
+    return select((x >= 0.) & (x < TWOPI), x, r);
+}
+
+/// Largest magnitude accepted by @c sincos (2^20 quadrants).
+constexpr double SINCOS_LIMIT = 0x1p+20 * 1.5707963267948966;
+
+/// Compute @c s = sin(x) and @c c = cos(x).
+/// @discussion Quadrant reduction by π/2 in four parts, then minimax polynomials on ±π/4.
+/// Valid for |x| < @c SINCOS_LIMIT.
+template <typename T>
+void sincos(T x, T & s, T & c)
+{
+    constexpr double PIO2_1 = 0x1.921fb544p+0;
+    constexpr double PIO2_2 = 0x1.0b4611a6p-34;
+    constexpr double PIO2_3 = 0x1.3198a2ep-69;
+    constexpr double PIO2_4 = 0x1.b839a252049c1p-104;
+    constexpr double INV_PIO2 = 0x1.45f306dc9c883p-1;
+
+    auto q = nearest(x * INV_PIO2);
+    auto r = (((x - q * PIO2_1) - q * PIO2_2) - q * PIO2_3) - q * PIO2_4;
+
+    // Quadrant 0..3.
+    auto m = q - 4. * floor(q * 0.25);
+
+    auto z = r * r;
+
+    // sin(r) on ±π/4.
+    constexpr double S1 = -1.66666666666666324348e-01;
+    constexpr double S2 =  8.33333333332248946124e-03;
+    constexpr double S3 = -1.98412698298579493134e-04;
+    constexpr double S4 =  2.75573137070700676789e-06;
+    constexpr double S5 = -2.50507602534068634195e-08;
+    constexpr double S6 =  1.58969099521155010221e-10;
+    auto sr = r + r * z * (S1 + z * (S2 + z * (S3 + z * (S4 + z * (S5 + z * S6)))));
+
+    // cos(r) on ±π/4.
+    constexpr double C1 =  4.16666666666666019037e-02;
+    constexpr double C2 = -1.38888888888741095749e-03;
+    constexpr double C3 =  2.48015872894767294178e-05;
+    constexpr double C4 = -2.75573143513906633035e-07;
+    constexpr double C5 =  2.08757232129817482790e-09;
+    constexpr double C6 = -1.13596475577881948265e-11;
+    auto hz = 0.5 * z;
+    auto w = 1. - hz;
+    auto cr = w + (((1. - w) - hz) + z * z * (C1 + z * (C2 + z * (C3 + z * (C4 + z * (C5 + z * C6))))));
+
+    //  m | sin  cos
+    // ---+----------
+    //  0 |  s    c
+    //  1 |  c   -s
+    //  2 | -s   -c
+    //  3 | -c    s
+    auto swap = (m == 1.) | (m == 3.);
+    s = select(swap, cr, sr);
+    c = select(swap, sr, cr);
+    s = select(m >= 2., -s, s);
+    c = select((m == 1.) | (m == 2.), -c, c);
+}
+
+/// @return Arc tangent of @c x, in the range ±π/2.
+/// @discussion Three-interval reduction and rational approximation (after Cephes).
+template <typename T>
+T atan(T x)
+{
+    constexpr double T3P8 = 2.41421356237309504880; // tan(3π/8)
+    constexpr double MOREBITS = 6.123233995736765886130e-17;
+
+    constexpr double P0 = -8.750608600031904122785e-01;
+    constexpr double P1 = -1.615753718733365076637e+01;
+    constexpr double P2 = -7.500855792314704667340e+01;
+    constexpr double P3 = -1.228866684490136173410e+02;
+    constexpr double P4 = -6.485021904942025371773e+01;
+
+    constexpr double Q0 =  2.485846490142306297962e+01;
+    constexpr double Q1 =  1.650270098316988542046e+02;
+    constexpr double Q2 =  4.328810604912902668951e+02;
+    constexpr double Q3 =  4.853903996359136964868e+02;
+    constexpr double Q4 =  1.945506571482613964425e+02;
+
+    auto ax = abs(x);
+    auto big = ax > T3P8;
+    auto mid = (ax > 0.66) & (ax <= T3P8);
+
+    auto y = select(big, T(M_PI_2), select(mid, T(M_PI_4), T(0.)));
+    auto corr = select(big, T(MOREBITS), select(mid, T(0.5 * MOREBITS), T(0.)));
+    auto r = select(big, -1. / ax, select(mid, (ax - 1.) / (ax + 1.), ax));
+
+    auto z = r * r;
+    auto p = (((P0 * z + P1) * z + P2) * z + P3) * z + P4;
+    auto q = ((((z + Q0) * z + Q1) * z + Q2) * z + Q3) * z + Q4;
+    auto a = y + ((r * (z * p / q) + r) + corr);
+
+    return select(x < 0., -a, a);
+}
+
+/// @return Direction of (@c x, @c y) in the range 0..2π, or zero if both are zero.
+/// @discussion Quadrants follow @c Vector::direction (a negative zero @c y is treated as positive).
+template <typename T>
+T atan2(T y, T x)
+{
+    constexpr double TWOPI = 0x1.921fb54442d18p+2;
+
+    auto ax = abs(x);
+    auto ay = abs(y);
+    auto swap = ay > ax;
+    auto num = select(swap, ax, ay);
+    auto den = select(swap, ay, ax);
+
+    auto a = atan(select(den == 0., T(0.), num / den));
+    a = select(swap, M_PI_2 - a, a);
+    a = select(x < 0., M_PI - a, a);
+    a = select(y < 0., TWOPI - a, a);
+    return select(a >= TWOPI, a - TWOPI, a);
+}
+
+/// @return √(x² + y²) without undue overflow or underflow.
+template <typename T>
+T hypot(T x, T y)
+{
+    auto ax = abs(x);
+    auto ay = abs(y);
+    auto m = select(ax > ay, ax, ay);
+    auto n = select(ax > ay, ay, ax);
+    auto r = select(m == 0., T(0.), n / m);
+    return m * sqrt(1. + r * r);
+}
+
+} // namespace simd
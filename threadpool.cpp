@@ -0,0 +1,249 @@
+#include "threadpool.hpp"
+
+#include <algorithm>
+
+namespace
+{
+
+/// @return std::uint64_t Chunks @c first up to @c last.
+inline std::uint64_t pack(std::uint64_t first, std::uint64_t last)
+{
+    return first | last << 32;
+}
+
+inline std::uint64_t first(std::uint64_t chunks)
+{
+    return chunks & 0xffffffff;
+}
+
+inline std::uint64_t last(std::uint64_t chunks)
+{
+    return chunks >> 32;
+}
+
+/// Whether this thread is running chunks of a loop.
+thread_local bool working = false;
+
+} // namespace
+
+ThreadPool::ThreadPool(std::size_t threads)
+    : threads_{}, shares_{}, running_{}, mutex_{}, start_{}, finish_{}, generation_{0}, busy_{0}, stop_{false},
+      body_{nullptr}, f_{nullptr}, size_{0}, grain_{0}
+{
+    if (threads == 0) {
+        threads = std::max(std::thread::hardware_concurrency(), 1u);
+    }
+
+    shares_.reset(new Share[threads]);
+    for (std::size_t i = 1; i < threads; ++i) {
+        threads_.emplace_back(&ThreadPool::loop, this, i);
+    }
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+    start_.notify_all();
+
+    for (auto & thread : threads_) {
+        thread.join();
+    }
+}
+
+ThreadPool & ThreadPool::shared()
+{
+    static ThreadPool pool;
+    return pool;
+}
+
+std::size_t ThreadPool::size() const
+{
+    return threads_.size() + 1;
+}
+
+void ThreadPool::run(std::size_t size, std::size_t grain, Body body, void * f)
+{
+    // Chunks are counted in 32 bits.
+    grain = std::max({grain, std::size_t(1), static_cast<std::size_t>(static_cast<std::uint64_t>(size) >> 32) + 1});
+    auto chunks = (size + grain - 1) / grain;
+
+    // Nested loops run serially, as do loops while another thread's runs.
+    std::unique_lock<std::mutex> running(running_, std::defer_lock);
+    if (threads_.empty() || chunks <= 1 || working || !running.try_lock()) {
+        for (std::size_t begin = 0; begin < size; begin += grain) {
+            body(f, begin, std::min(begin + grain, size));
+        }
+        return;
+    }
+
+    auto n = this->size();
+    for (std::size_t i = 0; i < n; ++i) {
+        shares_[i].chunks.store(pack(chunks * i / n, chunks * (i + 1) / n), std::memory_order_relaxed);
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        body_ = body;
+        f_ = f;
+        size_ = size;
+        grain_ = grain;
+        busy_ = threads_.size();
+        ++generation_;
+    }
+    start_.notify_all();
+
+    work(0);
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    finish_.wait(lock, [this] {
+        return busy_ == 0;
+    });
+}
+
+void ThreadPool::work(std::size_t index)
+{
+    auto n = size();
+    auto & own = shares_[index].chunks;
+    working = true;
+
+    for (;;) {
+        // Chunks are taken once each, as only the owner advances first and only thieves retreat last.
+        auto c = own.load();
+        while (first(c) < last(c)) {
+            if (own.compare_exchange_weak(c, c + 1)) {
+                auto begin = first(c) * grain_;
+                body_(f_, begin, std::min(begin + grain_, size_));
+                c = own.load();
+            }
+        }
+
+        // Steal the back half of another thread's chunks.
+        auto stolen = false;
+        for (std::size_t i = 1; i < n && !stolen; ++i) {
+            auto & other = shares_[(index + i) % n].chunks;
+            auto v = other.load();
+            while (!stolen && first(v) < last(v)) {
+                auto middle = last(v) - (last(v) - first(v) + 1) / 2;
+                if (other.compare_exchange_weak(v, pack(first(v), middle))) {
+                    own.store(pack(middle, last(v)));
+                    stolen = true;
+                }
+            }
+        }
+
+        if (!stolen) {
+            working = false;
+            return;
+        }
+    }
+}
+
+void ThreadPool::loop(std::size_t index)
+{
+    std::uint64_t generation = 0;
+    std::unique_lock<std::mutex> lock(mutex_);
+
+    for (;;) {
+        start_.wait(lock, [&] {
+            return stop_ || generation_ != generation;
+        });
+        if (stop_) {
+            return;
+        }
+        generation = generation_;
+
+        lock.unlock();
+        work(index);
+        lock.lock();
+
+        if (--busy_ == 0) {
+            finish_.notify_one();
+        }
+    }
+}
+
+#ifdef UNITTEST_THREADPOOL
+
+#include <cassert>
+#include <chrono>
+
+int main()
+{
+    {
+        ThreadPool pool;
+        assert(pool.size() == std::max(std::thread::hardware_concurrency(), 1u));
+        assert(ThreadPool::shared().size() == pool.size());
+        assert(&ThreadPool::shared() == &ThreadPool::shared());
+    }
+
+    for (std::size_t threads : {1, 2, 4, 7}) {
+        ThreadPool pool(threads);
+        assert(pool.size() == threads);
+
+        // Every element is visited once, in ranges on chunk boundaries.
+        for (std::size_t grain : {0, 1, 5, 64, 5000}) {
+            std::vector<std::atomic<int>> visits(1001);
+            std::atomic<std::size_t> calls{0};
+            pool.run(visits.size(), grain, [&](std::size_t begin, std::size_t end) {
+                assert(begin < end && end <= visits.size());
+                assert(begin % std::max(grain, std::size_t(1)) == 0);
+                assert(end - begin <= std::max(grain, std::size_t(1)));
+                for (auto i = begin; i < end; ++i) {
+                    ++visits[i];
+                }
+                ++calls;
+            });
+            for (auto & v : visits) {
+                assert(v == 1);
+            }
+            auto g = std::max(grain, std::size_t(1));
+            assert(calls == (visits.size() + g - 1) / g);
+        }
+
+        std::atomic<std::size_t> counted{0};
+        auto count = [&](std::size_t begin, std::size_t end) {
+            counted += end - begin;
+        };
+        pool.run(0, 1, count);
+        assert(counted == 0);
+        pool.run(10, 3, count);
+        assert(counted == 10);
+
+        // Nested loops, and loops run while another thread's is, run on the calling thread.
+        std::vector<std::atomic<std::size_t>> sums(17);
+        auto nested = [&](std::size_t begin, std::size_t end) {
+            for (auto i = begin; i < end; ++i) {
+                pool.run(100, 1, [&](std::size_t b, std::size_t e) {
+                    sums[i] += e - b;
+                });
+            }
+        };
+        std::thread other([&] {
+            pool.run(sums.size(), 1, nested);
+        });
+        pool.run(sums.size(), 1, nested);
+        other.join();
+        for (auto & sum : sums) {
+            assert(sum == 200);
+        }
+
+        // Slow chunks at the front are stolen by idle threads; output depends only on the index.
+        std::vector<double> out(257);
+        pool.run(out.size(), 3, [&](std::size_t begin, std::size_t end) {
+            if (begin < 48) {
+                std::this_thread::sleep_for(std::chrono::microseconds(200));
+            }
+            for (auto i = begin; i < end; ++i) {
+                out[i] = i * 0.5;
+            }
+        });
+        for (std::size_t i = 0; i < out.size(); ++i) {
+            assert(out[i] == i * 0.5);
+        }
+    }
+}
+
+#endif
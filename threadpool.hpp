@@ -0,0 +1,89 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/// Runs loops in parallel on a fixed set of threads, balanced by work stealing.
+/// @discussion A loop over @c size elements is cut into chunks of @c grain elements. Each thread (the calling
+/// thread included) starts with a contiguous share of the chunks, taking them from the front; a thread that
+/// runs out steals half of the chunks left to another, from the back.
+/// Chunk boundaries depend only on @c size and @c grain, so a loop that writes each element's result to its
+/// own index has the same output for any number of threads, in any schedule.
+/// A loop run from within a loop, or while another thread's loop is running on the pool, runs on the calling
+/// thread alone.
+class ThreadPool
+{
+public:
+    /// Default elements per chunk.
+    static constexpr std::size_t GRAIN = 4096;
+
+    /// Construct pool of @c threads threads, including the calling thread; zero for one per hardware thread.
+    explicit ThreadPool(std::size_t threads = 0);
+
+    ThreadPool(const ThreadPool &) = delete;
+    ThreadPool & operator=(const ThreadPool &) = delete;
+
+    /// Join the threads.
+    ~ThreadPool();
+
+    /// @return ThreadPool Pool of one thread per hardware thread, shared by the process.
+    static ThreadPool & shared();
+
+    /// @return std::size_t Number of threads, including the calling thread.
+    std::size_t size() const;
+
+    /// Call @c f(begin, end) for consecutive ranges of at most @c grain elements covering 0..@c size, in
+    /// parallel, and return when all calls have returned.
+    template <typename F>
+    void run(std::size_t size, std::size_t grain, F f);
+
+private:
+    /// Chunks left to a thread, as @c first in the low and @c last in the high 32 bits.
+    struct alignas(64) Share
+    {
+        std::atomic<std::uint64_t> chunks;
+    };
+
+    using Body = void (*)(void * f, std::size_t begin, std::size_t end);
+
+    /// Run @c body over 0..@c size in chunks of @c grain elements.
+    void run(std::size_t size, std::size_t grain, Body body, void * f);
+
+    /// Run chunks as thread @c index until none are left.
+    void work(std::size_t index);
+
+    /// Run the loops dispatched to thread @c index.
+    void loop(std::size_t index);
+
+    std::vector<std::thread> threads_;
+    std::unique_ptr<Share[]> shares_;
+
+    /// Held by the thread running a loop on the pool.
+    std::mutex running_;
+
+    std::mutex mutex_;
+    std::condition_variable start_;
+    std::condition_variable finish_;
+    std::uint64_t generation_;
+    std::size_t busy_;
+    bool stop_;
+
+    Body body_;
+    void * f_;
+    std::size_t size_;
+    std::size_t grain_;
+};
+
+template <typename F>
+void ThreadPool::run(std::size_t size, std::size_t grain, F f)
+{
+    run(size, grain, [](void * f, std::size_t begin, std::size_t end) {
+        (*static_cast<F *>(f))(begin, end);
+    }, &f);
+}
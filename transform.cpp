@@ -0,0 +1,144 @@
+#include "transform.hpp"
+
+template <typename T>
+BasicTransform<T> BasicTransform<T>::rotation(const Angle & direction)
+{
+    return rotation(UnitAngle(direction));
+}
+
+template <typename T>
+BasicTransform<T> & BasicTransform<T>::rotate(const Angle & direction)
+{
+    return rotate(UnitAngle(direction));
+}
+
+template class BasicTransform<float>;
+template class BasicTransform<double>;
+template class BasicTransform<long double>;
+
+#ifdef UNITTEST_TRANSFORM
+
+#include "fcmp.hpp"
+
+#include <cassert>
+#include <initializer_list>
+#include <limits>
+
+namespace
+{
+
+/// @return bool Whether points @c p and @c q match to @c precision decimal places.
+template <typename T>
+bool near(const BasicPoint<T> & p, const BasicPoint<T> & q, int precision)
+{
+    return fcmp(p.x(), q.x(), precision) && fcmp(p.y(), q.y(), precision);
+}
+
+/// Check transforms in precision @c T.
+template <typename T>
+void test()
+{
+    using Angle = BasicAngle<T>;
+    using Point = BasicPoint<T>;
+    using Transform = BasicTransform<T>;
+    using Vector = BasicVector<T>;
+
+    constexpr int precision = std::numeric_limits<T>::digits10 - 3;
+
+    // Identity and translation are exact.
+    {
+        constexpr auto i = Transform();
+        static_assert(i.xx() == 1 && i.xy() == 0 && i.yx() == 0 && i.yy() == 1);
+        static_assert(i.apply(Point{3, -4}).x() == 3 && i.apply(Point{3, -4}).y() == -4);
+
+        constexpr auto t = Transform::translation(Point{1, 2});
+        static_assert(t.apply(Point{3, 4}).x() == 4 && t.apply(Point{3, 4}).y() == 6);
+        static_assert((t * t).offset().x() == 2 && (t * t).offset().y() == 4);
+        static_assert(Transform().translate(Point{1, 2}).translate(Point{-1, 1}).offset().y() == 3);
+
+        constexpr auto v = t.apply(Vector(Point{1, 1}, Point{2, 3}));
+        static_assert(v.tail().x() == 2 && v.tail().y() == 3);
+        static_assert(v.head().x() == 3 && v.head().y() == 5);
+    }
+
+    // Rotation is about the origin.
+    {
+        auto r = Transform::rotation(Angle::degrees(90));
+        assert(near(r.apply(Point{1, 0}), Point{0, 1}, precision));
+        assert(near(r.apply(Point{2, 3}), Point{-3, 2}, precision));
+        assert(fcmp(r.xx(), 0, precision) && fcmp(r.xy(), -1, precision));
+        assert(fcmp(r.yx(), 1, precision) && fcmp(r.yy(), 0, precision));
+        assert(near(r.offset(), Point{}, precision));
+
+        auto t = Transform::translation(Point{1, 0});
+        assert(near((r * t).apply(Point{}), Point{0, 1}, precision));
+        assert(near((t * r).apply(Point{}), Point{1, 0}, precision));
+    }
+
+    // A rotate followed by translates matches the same steps on a vector in the standard position.
+    {
+        auto u = Vector(Point{1, 2}, Point{4, 6});
+        for (auto deg : {0, 30, 90, 200, 345}) {
+            auto v = Vector(Angle::degrees(T(deg)), 5);
+            auto w = Vector(v).rotate(u.direction()).translate(u.head()).translate(Point{-1, 1});
+            auto x = Transform().rotate(u.direction()).translate(u.head()).translate(Point{-1, 1}).apply(v);
+            assert(near(x.tail(), w.tail(), precision));
+            assert(near(x.head(), w.head(), precision));
+        }
+    }
+
+    // A rotation after a translation is about the origin, not the tail, so only displacements agree.
+    {
+        auto v = Vector(Angle::degrees(0), 5);
+        auto w = Vector(v).translate(Point{2, 0}).rotate(Angle::degrees(90));
+        auto x = Transform().translate(Point{2, 0}).rotate(Angle::degrees(90)).apply(v);
+        assert(near(w.tail(), Point{}, precision));
+        assert(near(w.head(), Point{0, 5}, precision));
+        assert(near(x.tail(), Point{0, 2}, precision));
+        assert(near(x.head(), Point{0, 7}, precision));
+        assert(near(x.head() - x.tail(), w.head() - w.tail(), precision));
+    }
+
+    // Composition applies the right-hand transform first.
+    {
+        auto a = Transform().rotate(Angle::degrees(30)).translate(Point{2, -1});
+        auto b = Transform().translate(Point{-3, 5}).rotate(Angle::degrees(100));
+        auto p = Point{0.5, 7};
+        assert(near((a * b).apply(p), a.apply(b.apply(p)), precision));
+        assert(near((b * a).apply(p), b.apply(a.apply(p)), precision));
+    }
+
+    // Whole turns return to the identity.
+    {
+        auto m = Transform();
+        for (auto i = 0; i < 360; ++i) {
+            m.rotate(Angle::degrees(1));
+        }
+        assert(near(m.apply(Point{3, 4}), Point{3, 4}, precision - 2));
+    }
+
+    // Unit angles give the same transforms as angles.
+    {
+        using UnitAngle = BasicUnitAngle<T>;
+
+        auto a = Angle::degrees(30);
+        auto m = Transform().rotate(UnitAngle(a)).translate(Point{2, -1});
+        auto n = Transform().rotate(a).translate(Point{2, -1});
+        assert(m.xx() == n.xx() && m.xy() == n.xy() && m.yx() == n.yx() && m.yy() == n.yy());
+        assert(Transform::rotation(UnitAngle(a)).apply(Point{3, 4}) == Transform::rotation(a).apply(Point{3, 4}));
+
+        constexpr auto r = Transform::rotation(UnitAngle());
+        static_assert(r.xx() == 1 && r.xy() == 0 && r.yx() == 0 && r.yy() == 1);
+    }
+}
+
+} // namespace
+
+int main()
+{
+    test<float>();
+    test<double>();
+    test<long double>();
+}
+
+#endif
@@ -0,0 +1,187 @@
+#pragma once
+
+#include "angle.hpp"
+#include "point.hpp"
+#include "unitangle.hpp"
+#include "vector.hpp"
+
+/// Models a 2D affine transform of points, in floating point type @c T.
+/// @see https://en.wikipedia.org/wiki/Affine_transformation
+/// @discussion Rotations and translations accumulate into a single matrix, so a chain costs one
+/// matrix-vector product per point however long it is:
+/// @code
+/// | xx xy x | |px|
+/// | yx yy y | |py|
+/// |  0  0 1 | | 1|
+/// @endcode
+/// Rotations are about the origin, and vectors are transformed by their tail and head. @c Vector::rotate
+/// instead rotates about the tail and returns the vector to the standard position, so the two chains of the
+/// same steps agree in tail and head only while no rotation follows a translation (e.g. a single rotate followed
+/// by translates, for a vector in the standard position). Otherwise only their displacements agree.
+/// Instantiated for @c float, @c double and @c long double.
+/// @see Transform
+template <typename T>
+class BasicTransform
+{
+public:
+    using Angle = BasicAngle<T>;
+    using Point = BasicPoint<T>;
+    using UnitAngle = BasicUnitAngle<T>;
+    using Vector = BasicVector<T>;
+
+    /// Construct the identity transform.
+    constexpr BasicTransform();
+
+    /// Construct transform rotating by @c direction about the origin.
+    static BasicTransform rotation(const Angle & direction);
+
+    /// Construct transform rotating by @c direction about the origin, from its cached sine and cosine.
+    static constexpr BasicTransform rotation(const UnitAngle & direction);
+
+    /// Construct transform translating by @c point.
+    static constexpr BasicTransform translation(const Point & point);
+
+    /// Mutate transform by following it with a rotation by @c direction about the origin.
+    BasicTransform & rotate(const Angle & direction);
+
+    /// Mutate transform by following it with a rotation by @c direction about the origin, from its cached sine
+    /// and cosine.
+    constexpr BasicTransform & rotate(const UnitAngle & direction);
+
+    /// Mutate transform by following it with a translation by @c point.
+    constexpr BasicTransform & translate(const Point & point);
+
+    /// @return Point @c point transformed.
+    constexpr Point apply(const Point & point) const;
+
+    /// @return Vector @c v with its tail and head transformed.
+    constexpr Vector apply(const Vector & v) const;
+
+    /// @return T Coefficient of @c x in the transformed @c x.
+    constexpr T xx() const;
+
+    /// @return T Coefficient of @c y in the transformed @c x.
+    constexpr T xy() const;
+
+    /// @return T Coefficient of @c x in the transformed @c y.
+    constexpr T yx() const;
+
+    /// @return T Coefficient of @c y in the transformed @c y.
+    constexpr T yy() const;
+
+    /// @return Point Translation, applied after the linear part.
+    constexpr Point offset() const;
+
+    /// Compose transforms.
+    /// @return BasicTransform Transform applying @c other, then this.
+    constexpr BasicTransform operator*(const BasicTransform & other) const;
+
+private:
+    /// Private constructor.
+    constexpr BasicTransform(T xx, T xy, T yx, T yy, T x, T y);
+
+    T xx_;
+    T xy_;
+    T yx_;
+    T yy_;
+    T x_;
+    T y_;
+};
+
+/// Transform in double precision.
+using Transform = BasicTransform<double>;
+
+template <typename T>
+constexpr BasicTransform<T>::BasicTransform() : BasicTransform(1, 0, 0, 1, 0, 0)
+{
+}
+
+template <typename T>
+constexpr BasicTransform<T>::BasicTransform(T xx, T xy, T yx, T yy, T x, T y) :
+    xx_{xx}, xy_{xy}, yx_{yx}, yy_{yy}, x_{x}, y_{y}
+{
+}
+
+template <typename T>
+constexpr BasicTransform<T> BasicTransform<T>::rotation(const UnitAngle & direction)
+{
+    // | cos -sin |
+    // | sin  cos |
+    auto c = direction.cos();
+    auto s = direction.sin();
+    return BasicTransform(c, -s, s, c, 0, 0);
+}
+
+template <typename T>
+constexpr BasicTransform<T> & BasicTransform<T>::rotate(const UnitAngle & direction)
+{
+    *this = rotation(direction) * *this;
+    return *this;
+}
+
+template <typename T>
+constexpr BasicTransform<T> BasicTransform<T>::translation(const Point & point)
+{
+    return BasicTransform(1, 0, 0, 1, point.x(), point.y());
+}
+
+template <typename T>
+constexpr BasicTransform<T> & BasicTransform<T>::translate(const Point & point)
+{
+    x_ += point.x();
+    y_ += point.y();
+    return *this;
+}
+
+template <typename T>
+constexpr BasicPoint<T> BasicTransform<T>::apply(const Point & point) const
+{
+    return Point{xx_ * point.x() + xy_ * point.y() + x_, yx_ * point.x() + yy_ * point.y() + y_};
+}
+
+template <typename T>
+constexpr BasicVector<T> BasicTransform<T>::apply(const Vector & v) const
+{
+    return Vector{apply(v.tail()), apply(v.head())};
+}
+
+template <typename T>
+constexpr T BasicTransform<T>::xx() const
+{
+    return xx_;
+}
+
+template <typename T>
+constexpr T BasicTransform<T>::xy() const
+{
+    return xy_;
+}
+
+template <typename T>
+constexpr T BasicTransform<T>::yx() const
+{
+    return yx_;
+}
+
+template <typename T>
+constexpr T BasicTransform<T>::yy() const
+{
+    return yy_;
+}
+
+template <typename T>
+constexpr BasicPoint<T> BasicTransform<T>::offset() const
+{
+    return Point{x_, y_};
+}
+
+template <typename T>
+constexpr BasicTransform<T> BasicTransform<T>::operator*(const BasicTransform & other) const
+{
+    return BasicTransform(xx_ * other.xx_ + xy_ * other.yx_,
+                          xx_ * other.xy_ + xy_ * other.yy_,
+                          yx_ * other.xx_ + yy_ * other.yx_,
+                          yx_ * other.xy_ + yy_ * other.yy_,
+                          xx_ * other.x_ + xy_ * other.y_ + x_,
+                          yx_ * other.x_ + yy_ * other.y_ + y_);
+}
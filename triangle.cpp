@@ -1,139 +1,134 @@
 #include "triangle.hpp"
 
-#include "rightangledtriangle.hpp"
+#include "format.hpp"
 
-#include <cmath>
-#include <iomanip>
-#include <sstream>
-
-namespace
+template <typename T>
+BasicTriangle<T>::BasicTriangle(T a, T b, T c) : BasicTriangle(a, b, c, &solve<trig::Libm>)
 {
+}
 
-/// @return @c x squared.
-inline double sqr(double x)
+template <typename T>
+BasicTriangle<T>::BasicTriangle(T a, T b, T c, Solver solve) :
+    A_{}, B_{}, C_{}, known_{0}, solve_{solve}, a_{a}, b_{b}, c_{c}
 {
-    return pow(x, 2);
 }
 
-inline Angle C_from_a_b_c(double a, double b, double c)
+template <typename T>
+BasicTriangle<T>::BasicTriangle(const BasicTriangle & other) :
+    A_{}, B_{}, C_{}, known_{0}, solve_{other.solve_}, a_{other.a_}, b_{other.b_}, c_{other.c_}
 {
-    // Cosine rule:
-    // c2 = a2 + b2 − 2ab cos(C)
-    // Thus C = acos(a2 + b2 - c2 / 2ab)
-    return Angle::radians(acos((sqr(a) + sqr(b) - sqr(c)) / (2 * a * b)));
+    *this = other;
 }
 
-/// @return double c^2
-inline double cosine_rule(double a, double b, const Angle & C)
+template <typename T>
+BasicTriangle<T> & BasicTriangle<T>::operator=(const BasicTriangle & other)
 {
-    // Cosine rule:
-    // c2 = a2 + b2 − 2ab cos(C)
-    return sqr(a) + sqr(b) - 2 * a * b * cos(C);
+    // Angles are read only once known, so copying races with no other thread solving them.
+    auto known = static_cast<unsigned char>(other.known_.load(std::memory_order_acquire) & ~SOLVING);
+    A_ = known & KNOWN_A ? other.A_ : Angle();
+    B_ = known & KNOWN_B ? other.B_ : Angle();
+    C_ = known & KNOWN_C ? other.C_ : Angle();
+    known_.store(known, std::memory_order_relaxed);
+    solve_ = other.solve_;
+    a_ = other.a_;
+    b_ = other.b_;
+    c_ = other.c_;
+    return *this;
 }
 
-/// @return Length @c a.
-inline double sine_rule(const Angle & A, double ratio)
+template <typename T>
+std::string BasicTriangle<T>::description() const
 {
-    // Sine rule:
-    // sin(A)/a = ratio = sin(B)/b = sin(C)/c
-    return sin(A) / ratio;
+    return describe(*this);
 }
 
-/// @return Angle @c A.
-inline Angle sine_rule(double a, double ratio)
+template <typename T>
+std::size_t BasicTriangle<T>::format_to(char * buffer, std::size_t size) const
 {
-    return Angle::radians(asin(ratio * a));
+    auto A = this->A();
+    auto B = this->B();
+    auto C = this->C();
+    return (Format(buffer, size) << "Triangle "
+        << a() << ", "
+        << b() << ", "
+        << c() << "; "
+        << A << " (" << A.deg() << "°), "
+        << B << " (" << B.deg() << "°), "
+        << C << " (" << C.deg() << ")").size();
 }
 
-} // namespace
+template class BasicTriangle<float>;
+template class BasicTriangle<double>;
+template class BasicTriangle<long double>;
 
-Triangle::Triangle(double a, double b, double c) : a_{a}, b_{b}, c_{c}
-{
-    C_ = C_from_a_b_c(a_, b_, c_);
+#ifdef UNITTEST_TRIANGLE
 
-    auto ratio = sin(C_) / c_;
-    A_ = sine_rule(a_, ratio);
+#include "fcmp.hpp"
 
-    // 180° total
-    B_ = Angle::radians(Angle::degrees(180.) - A_ - C_);
-}
+#include <algorithm>
+#include <cassert>
+#include <limits>
+#include <thread>
+#include <vector>
 
-Triangle Triangle::with_a_b_C(double a, double b, const Angle & C)
+namespace
 {
-    return Triangle(a, b, sqrt(cosine_rule(a, b, C)));
-}
 
-Triangle Triangle::with_A_B_c(const Angle & A, const Angle & B, double c)
+/// @return bool Whether @c t matches @c u within relative @c tolerance.
+template <typename T>
+bool near(const BasicTriangle<T> & t, const BasicTriangle<T> & u, double tolerance)
 {
-    // 180° total
-    auto C = Angle::radians(Angle::degrees(180.) - A - B);
-    auto ratio = sin(C) / c;
-    auto a = sine_rule(A, ratio);
-    auto b = sine_rule(B, ratio);
-    return Triangle(a, b, c);
+    return std::fabs(t.A().rad() - u.A().rad()) <= tolerance * u.A().rad()
+        && std::fabs(t.B().rad() - u.B().rad()) <= tolerance * u.B().rad()
+        && std::fabs(t.C().rad() - u.C().rad()) <= tolerance * u.C().rad()
+        && std::fabs(t.a() - u.a()) <= tolerance * u.a()
+        && std::fabs(t.b() - u.b()) <= tolerance * u.b()
+        && std::fabs(t.c() - u.c()) <= tolerance * u.c();
 }
 
-RightAngledTriangle Triangle::subA() const
+/// Solve in precision @c T with trigonometry policy @c Trig, within relative @c tolerance of libm.
+/// @discussion Policies other than libm evaluate in double, so agree with libm only to the precision of @c T.
+template <typename T, typename Trig>
+void check(double tolerance)
 {
-    return RightAngledTriangle::with_A_c(A(), b());
-}
+    using Angle = BasicAngle<T>;
+    using Triangle = BasicTriangle<T>;
+    using Libm = trig::Libm;
 
-RightAngledTriangle Triangle::subB() const
-{
-    return RightAngledTriangle::with_A_c(B(), a());
-}
+    if (!std::is_same_v<Trig, Libm>) {
+        tolerance = std::max(tolerance, 16. * static_cast<double>(std::numeric_limits<T>::epsilon()));
+    }
 
-Angle Triangle::A() const
-{
-    return A_;
-}
+    auto t = Triangle::template with_a_b_c<Trig>(23.41209, 30.098, 44.00033);
+    auto u = Triangle::template with_a_b_c<Libm>(23.41209, 30.098, 44.00033);
+    assert(near(t, u, tolerance));
 
-Angle Triangle::B() const
-{
-    return B_;
-}
+    t = Triangle::template with_a_b_C<Trig>(5, 5, Angle::degrees(106.26));
+    u = Triangle::template with_a_b_C<Libm>(5, 5, Angle::degrees(106.26));
+    assert(near(t, u, tolerance));
 
-Angle Triangle::C() const
-{
-    return C_;
-}
+    t = Triangle::template with_A_B_c<Trig>(Angle::degrees(30), Angle::degrees(40), 50);
+    u = Triangle::template with_A_B_c<Libm>(Angle::degrees(30), Angle::degrees(40), 50);
+    assert(near(t, u, tolerance));
 
-double Triangle::a() const
-{
-    return a_;
-}
+    auto m = t.template subA<Trig>();
+    auto n = u.template subA<Libm>();
+    assert(fabs(m.a() - n.a()) <= tolerance * n.a());
+    assert(fabs(m.b() - n.b()) <= tolerance * n.b());
 
-double Triangle::b() const
-{
-    return b_;
-}
-
-double Triangle::c() const
-{
-    return c_;
+    m = t.template subB<Trig>();
+    n = u.template subB<Libm>();
+    assert(fabs(m.a() - n.a()) <= tolerance * n.a());
+    assert(fabs(m.b() - n.b()) <= tolerance * n.b());
 }
 
-std::string Triangle::description() const
+/// Check triangles in precision @c T.
+template <typename T>
+void test()
 {
-    std::stringstream ss;
-    ss << "Triangle "
-        << a() << ", "
-        << b() << ", "
-        << c() << "; "
-        << A() << " (" << A().deg() << "°), "
-        << B() << " (" << B().deg() << "°), "
-        << C() << " (" << C().deg() << ")";
-    return ss.str();
-}
-
-#ifdef UNITTEST_TRIANGLE
-
-#include "fcmp.hpp"
+    using Angle = BasicAngle<T>;
+    using Triangle = BasicTriangle<T>;
 
-#include <cassert>
-
-int main()
-{
     auto t = Triangle(23.41209, 30.098, 44.00033);
     assert(fcmp(t.A(), Angle::degrees(30)));
     assert(fcmp(t.B(), Angle::degrees(40)));
@@ -172,7 +167,73 @@ int main()
 
     assert(fcmp(m.b() + n.b(), t.c()));
 
+    {
+        // Angles solve on first access, in any order, to the same values.
+        auto u = Triangle(23.41209, 30.098, 44.00033);
+        auto v = u;
+        auto w = u;
+        assert(u.B() == Triangle(23.41209, 30.098, 44.00033).B());
+        assert(v.A() == u.A() && v.B() == u.B() && v.C() == u.C());
+        assert(w.C() == u.C() && w.A() == u.A() && w.B() == u.B());
+
+        // Given angles seed the cache.
+        auto A = Angle::degrees(30);
+        auto B = Angle::degrees(40);
+        auto s = Triangle::with_A_B_c(A, B, 50);
+        assert(s.A() == A && s.B() == B);
+        assert(s.C() == Angle::radians(Angle::degrees(180.) - A - B));
+
+        auto C = Angle::degrees(106.26);
+        assert(Triangle::with_a_b_C(5, 5, C).C() == C);
+    }
+
+    {
+        // Copies carry the angles known so far.
+        auto u = Triangle(23.41209, 30.098, 44.00033);
+        auto C = u.C();
+        auto v = u;
+        auto w = Triangle(1, 1, 1);
+        w = u;
+        assert(v.C() == C && w.C() == C);
+        assert(v.A() == u.A() && w.B() == u.B());
+    }
+
+    {
+        // Const triangles may be read from many threads at once.
+        const auto u = Triangle(23.41209, 30.098, 44.00033);
+        const auto expected = Triangle(23.41209, 30.098, 44.00033);
+        std::vector<std::thread> threads;
+        for (auto i = 0; i < 4; ++i) {
+            threads.emplace_back([&u, &expected, i] {
+                for (auto j = 0; j < 100; ++j) {
+                    auto angle = (i + j) % 3 == 0 ? &Triangle::A : (i + j) % 3 == 1 ? &Triangle::B : &Triangle::C;
+                    assert((u.*angle)() == (expected.*angle)());
+                }
+            });
+        }
+        for (auto & thread : threads) {
+            thread.join();
+        }
+        assert(u.A() == expected.A() && u.B() == expected.B() && u.C() == expected.C());
+    }
+
     assert(Triangle::with_a_b_C(5, 5, Angle::degrees(106.26)).description() == std::string("Triangle 5, 5, 7.99999; 0.643503 (36.87°), 0.643503 (36.87°), 1.85459 (106.26)"));
+
+    check<T, trig::Libm>(0.);
+    check<T, trig::Minimax<3>>(1e-4);
+    check<T, trig::Minimax<4>>(1e-6);
+    check<T, trig::Minimax<5>>(1e-7);
+    check<T, trig::Table<256>>(1e-10);
+    check<T, trig::Table<4096>>(1e-13);
+}
+
+} // namespace
+
+int main()
+{
+    test<float>();
+    test<double>();
+    test<long double>();
 }
 
 #endif
@@ -1,30 +1,60 @@
 #pragma once
 
 #include "angle.hpp"
+#include "rightangledtriangle.hpp"
+#include "trig.hpp"
 
+#include <atomic>
+#include <cmath>
+#include <cstddef>
 #include <string>
 
-class RightAngledTriangle;
+class Dataset;
 
 /// Models a triangle with sides @c a, @c b, and @c.
-class Triangle
+/// @discussion Factories take a trigonometry policy (@see trig.hpp), defaulting to libm.
+/// Angles are solved on first access and cached; factories given angles seed the cache.
+/// Const member functions may be called concurrently: the cache is published by an atomic set of known angles
+/// (release on store, acquire on load), and only one thread at a time stores to it. A thread finding another
+/// mid-store returns the angle it solved without caching it.
+/// Instantiated for @c float, @c double and @c long double.
+/// @see Triangle
+template <typename T>
+class BasicTriangle
 {
 public:
+    using Angle = BasicAngle<T>;
+    using RightAngledTriangle = BasicRightAngledTriangle<T>;
+
+    /// Construct triangle with sides @c a, @c b, and @c c.
+    BasicTriangle(T a, T b, T c);
+
+    /// Construct copy of @c other, with those of its angles already known.
+    BasicTriangle(const BasicTriangle & other);
+
+    /// Assign copy of @c other, with those of its angles already known.
+    BasicTriangle & operator=(const BasicTriangle & other);
+
     /// Construct triangle with sides @c a, @c b, and @c c.
-    Triangle(double a, double b, double c);
+    template <typename Trig = trig::Libm>
+    static BasicTriangle with_a_b_c(T a, T b, T c);
 
     /// Construct triangle with sides @c a and @c b, and angle @c C.
-    static Triangle with_a_b_C(double a, double b, const Angle & C);
+    template <typename Trig = trig::Libm>
+    static BasicTriangle with_a_b_C(T a, T b, const Angle & C);
 
     /// Construct triangle with angles @c A and @c B, and side @c C.
-    static Triangle with_A_B_c(const Angle & A, const Angle & B, double c);
+    template <typename Trig = trig::Libm>
+    static BasicTriangle with_A_B_c(const Angle & A, const Angle & B, T c);
 
     /// Split triangle into right-angled triangle.
     /// @return New right-angled triangle with angle @c A and hypotenuse @c b.
+    template <typename Trig = trig::Libm>
     RightAngledTriangle subA() const;
 
     /// Split triangle into right-angled triangle.
     /// @return New right-angled triangle with angle @c B and hypotenuse @c a.
+    template <typename Trig = trig::Libm>
     RightAngledTriangle subB() const;
 
     /// @return double Angle @c A (which is opposite side @c a).
@@ -36,23 +66,219 @@ public:
     /// @return double Angle @c C (which is opposite side @c c).
     Angle C() const;
 
-    /// @return double Length of opposite side @c a.
-    double a() const;
+    /// @return T Length of opposite side @c a.
+    constexpr T a() const;
 
-    /// @return double Length of adjacent side @c b.
-    double b() const;
+    /// @return T Length of adjacent side @c b.
+    constexpr T b() const;
 
-    /// @return double Length of hypotenuse @c c.
-    double c() const;
+    /// @return T Length of hypotenuse @c c.
+    constexpr T c() const;
 
     /// @return std::string Description.
     std::string description() const;
 
+    /// Format description into @c buffer of @c size characters, without allocating.
+    /// @discussion Writes at most @c size characters, without a terminator; the output matches @c description.
+    /// @see format_to(const T &, OutputIt) to format to an output iterator.
+    /// @return std::size_t Length of the whole description.
+    std::size_t format_to(char * buffer, std::size_t size) const;
+
 private:
-    Angle A_;
-    Angle B_;
-    Angle C_;
-    double a_;
-    double b_;
-    double c_;
+    /// Bits of @c known_.
+    enum : unsigned char
+    {
+        KNOWN_A = 1,
+        KNOWN_B = 2,
+        KNOWN_C = 4,
+        SOLVING = 8,
+    };
+
+    /// Solver for the angle named by @c want, as a bit of @c known_.
+    using Solver = BasicAngle<T> (*)(const BasicTriangle &, unsigned char want);
+
+    /// Construct triangle with sides @c a, @c b, and @c c, whose angles are found by @c solve.
+    BasicTriangle(T a, T b, T c, Solver solve);
+
+    /// Construct triangle with sides @c a, @c b, and @c c, and known angles @c A, @c B, and @c C.
+    /// @discussion For readers of triangles stored with their angles.
+    BasicTriangle(T a, T b, T c, const Angle & A, const Angle & B, const Angle & C);
+
+    friend class ::Dataset;
+
+    /// Solve the angle named by @c want with trigonometry policy @c Trig, and those it depends on, caching them.
+    /// @return Angle The angle named by @c want.
+    template <typename Trig>
+    static Angle solve(const BasicTriangle & t, unsigned char want);
+
+    mutable Angle A_;
+    mutable Angle B_;
+    mutable Angle C_;
+    mutable std::atomic<unsigned char> known_;
+    Solver solve_;
+    T a_;
+    T b_;
+    T c_;
 };
+
+/// Triangle in double precision.
+using Triangle = BasicTriangle<double>;
+
+template <typename T>
+inline BasicTriangle<T>::BasicTriangle(T a, T b, T c, const Angle & A, const Angle & B, const Angle & C) :
+    A_{A}, B_{B}, C_{C}, known_{KNOWN_A | KNOWN_B | KNOWN_C}, solve_{&solve<trig::Libm>}, a_{a}, b_{b}, c_{c}
+{
+}
+
+template <typename T>
+inline BasicAngle<T> BasicTriangle<T>::A() const
+{
+    if (!(known_.load(std::memory_order_acquire) & KNOWN_A)) {
+        return solve_(*this, KNOWN_A);
+    }
+    return A_;
+}
+
+template <typename T>
+inline BasicAngle<T> BasicTriangle<T>::B() const
+{
+    if (!(known_.load(std::memory_order_acquire) & KNOWN_B)) {
+        return solve_(*this, KNOWN_B);
+    }
+    return B_;
+}
+
+template <typename T>
+inline BasicAngle<T> BasicTriangle<T>::C() const
+{
+    if (!(known_.load(std::memory_order_acquire) & KNOWN_C)) {
+        return solve_(*this, KNOWN_C);
+    }
+    return C_;
+}
+
+template <typename T>
+constexpr T BasicTriangle<T>::a() const
+{
+    return a_;
+}
+
+template <typename T>
+constexpr T BasicTriangle<T>::b() const
+{
+    return b_;
+}
+
+template <typename T>
+constexpr T BasicTriangle<T>::c() const
+{
+    return c_;
+}
+
+template <typename T>
+template <typename Trig>
+BasicTriangle<T> BasicTriangle<T>::with_a_b_c(T a, T b, T c)
+{
+    return BasicTriangle(a, b, c, &solve<Trig>);
+}
+
+template <typename T>
+template <typename Trig>
+BasicTriangle<T> BasicTriangle<T>::with_a_b_C(T a, T b, const Angle & C)
+{
+    // Cosine rule:
+    // c2 = a2 + b2 − 2ab cos(C)
+    auto t = BasicTriangle(a, b, std::sqrt(a * a + b * b - 2 * a * b * Trig::cos(C)), &solve<Trig>);
+    t.C_ = C;
+    t.known_ = KNOWN_C;
+    return t;
+}
+
+template <typename T>
+template <typename Trig>
+BasicTriangle<T> BasicTriangle<T>::with_A_B_c(const Angle & A, const Angle & B, T c)
+{
+    // 180° total
+    auto C = Angle::radians(Angle::degrees(180.) - A - B);
+
+    // Sine rule:
+    // sin(A)/a = ratio = sin(B)/b = sin(C)/c
+    auto ratio = Trig::sin(C) / c;
+    auto t = BasicTriangle(Trig::sin(A) / ratio, Trig::sin(B) / ratio, c, &solve<Trig>);
+    t.A_ = A;
+    t.B_ = B;
+    t.C_ = C;
+    t.known_ = KNOWN_A | KNOWN_B | KNOWN_C;
+    return t;
+}
+
+template <typename T>
+template <typename Trig>
+BasicRightAngledTriangle<T> BasicTriangle<T>::subA() const
+{
+    return RightAngledTriangle::template with_A_c<Trig>(A(), b());
+}
+
+template <typename T>
+template <typename Trig>
+BasicRightAngledTriangle<T> BasicTriangle<T>::subB() const
+{
+    return RightAngledTriangle::template with_A_c<Trig>(B(), a());
+}
+
+template <typename T>
+template <typename Trig>
+BasicAngle<T> BasicTriangle<T>::solve(const BasicTriangle & t, unsigned char want)
+{
+    TRIG_COUNT(TRIANGLE_SOLVE);
+
+    // B depends on A, which depends on C.
+    auto known = t.known_.load(std::memory_order_acquire);
+    auto solved = static_cast<unsigned char>(KNOWN_C);
+    auto C = Angle();
+    if (known & KNOWN_C) {
+        C = t.C_;
+    } else {
+        // Cosine rule:
+        // c2 = a2 + b2 − 2ab cos(C)
+        // Thus C = acos(a2 + b2 - c2 / 2ab)
+        C = Angle::radians(Trig::acos((t.a_ * t.a_ + t.b_ * t.b_ - t.c_ * t.c_) / (2 * t.a_ * t.b_)));
+    }
+
+    auto A = Angle();
+    if (want & (KNOWN_A | KNOWN_B)) {
+        solved |= KNOWN_A;
+        if (known & KNOWN_A) {
+            A = t.A_;
+        } else {
+            // Sine rule:
+            // sin(A)/a = ratio = sin(B)/b = sin(C)/c
+            auto ratio = Trig::sin(C) / t.c_;
+            A = Angle::radians(Trig::asin(ratio * t.a_));
+        }
+    }
+
+    auto B = Angle();
+    if (want & KNOWN_B) {
+        // 180° total
+        solved |= KNOWN_B;
+        B = Angle::radians(Angle::degrees(180.) - A - C);
+    }
+
+    // Store only the angles still unknown, and only if no other thread is storing.
+    if (!(t.known_.fetch_or(SOLVING, std::memory_order_acquire) & SOLVING)) {
+        known = t.known_.load(std::memory_order_relaxed);
+        if (!(known & KNOWN_A) && (solved & KNOWN_A)) {
+            t.A_ = A;
+        }
+        if (!(known & KNOWN_B) && (solved & KNOWN_B)) {
+            t.B_ = B;
+        }
+        if (!(known & KNOWN_C)) {
+            t.C_ = C;
+        }
+        t.known_.store((known | solved) & ~SOLVING, std::memory_order_release);
+    }
+
+    return want == KNOWN_A ? A : want == KNOWN_B ? B : C;
+}
@@ -0,0 +1,137 @@
+#include "trianglebatch.hpp"
+
+#include "simd.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cfloat>
+
+std::size_t TriangleBatch::solve(const double * a, const double * b, const double * c, std::size_t size,
+                                 double * A, double * B, double * C, bool * valid)
+{
+    simd::for_each(size, [&](std::size_t i, auto t) {
+        using T = decltype(t);
+
+        auto x = simd::load<T>(a + i);
+        auto y = simd::load<T>(b + i);
+        auto z = simd::load<T>(c + i);
+
+        // Angles are scale-invariant, so normalise by the longest side against overflow and underflow.
+        auto m = simd::select(x > y, x, y);
+        m = simd::select(m > z, m, z);
+        // Divide, since the reciprocal of a subnormal side overflows.
+        x = x / m;
+        y = y / m;
+        z = z / m;
+
+        auto s1 = y + z - x;
+        auto s2 = x + z - y;
+        auto s3 = x + y - z;
+        auto ok = (s1 > 0.) & (s2 > 0.) & (s3 > 0.) & (m <= DBL_MAX);
+
+        // 4K, where K is the area.
+        auto k = simd::sqrt((x + y + z) * s1 * s2 * s3);
+
+        auto x2 = x * x;
+        auto y2 = y * y;
+        auto z2 = z * z;
+        simd::store(A + i, simd::select(ok, simd::atan2(k, y2 + z2 - x2), T(0.)));
+        simd::store(B + i, simd::select(ok, simd::atan2(k, x2 + z2 - y2), T(0.)));
+        simd::store(C + i, simd::select(ok, simd::atan2(k, x2 + y2 - z2), T(0.)));
+        simd::store(valid + i, ok);
+    });
+
+    return std::count(valid, valid + size, true);
+}
+
+std::size_t TriangleBatch::solve(ThreadPool & pool, const double * a, const double * b, const double * c,
+                                 std::size_t size, double * A, double * B, double * C, bool * valid, std::size_t grain)
+{
+    std::atomic<std::size_t> count{0};
+    pool.run(size, grain, [&](std::size_t begin, std::size_t end) {
+        count += solve(a + begin, b + begin, c + begin, end - begin, A + begin, B + begin, C + begin, valid + begin);
+    });
+    return count;
+}
+
+#ifdef UNITTEST_TRIANGLEBATCH
+
+#include "triangle.hpp"
+
+#include <cassert>
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <vector>
+
+int main()
+{
+    constexpr auto inf = std::numeric_limits<double>::infinity();
+    constexpr auto nan = std::numeric_limits<double>::quiet_NaN();
+
+    // Valid triangles, then degenerate and impossible ones.
+    std::vector<double> a = {23.41209, 3, 5, 1, 1e-200, 1e200, 7, 2, 1e-310, 1, 1, 0, -3, inf, nan, 1};
+    std::vector<double> b = {30.098, 4, 5, 1, 1e-200, 1e200, 3, 3, 1e-310, 1, 2, 1, 4, 1, 1, inf};
+    std::vector<double> c = {44.00033, 5, 8, 1, 1.5e-200, 1.5e200, 5, 4, 1.5e-310, 2, 4, 1, 5, 1, 1, inf};
+    constexpr std::size_t VALID = 9;
+
+    auto size = a.size();
+    std::vector<double> A(size), B(size), C(size);
+    std::unique_ptr<bool[]> valid(new bool[size]);
+
+    assert(TriangleBatch::solve(a.data(), b.data(), c.data(), size, A.data(), B.data(), C.data(), valid.get()) == VALID);
+
+    for (std::size_t i = 0; i < size; ++i) {
+        assert(valid[i] == (i < VALID));
+        if (!valid[i]) {
+            assert(A[i] == 0. && B[i] == 0. && C[i] == 0.);
+            continue;
+        }
+
+        assert(fabs(A[i] + B[i] + C[i] - M_PI) <= 1e-15);
+
+        // The scalar sine rule folds obtuse A onto acute.
+        auto t = Triangle(a[i], b[i], c[i]);
+        if (A[i] < M_PI_2 && fabs(a[i]) < 1e100 && fabs(a[i]) > 1e-100) {
+            assert(fabs(A[i] - t.A().rad()) <= 1e-14);
+            assert(fabs(B[i] - t.B().rad()) <= 1e-14);
+            assert(fabs(C[i] - t.C().rad()) <= 1e-14);
+        }
+    }
+
+    // 3-4-5: right angle opposite c.
+    assert(fabs(C[1] - M_PI_2) <= 1e-15);
+
+    // Equilateral.
+    assert(fabs(A[3] - M_PI / 3) <= 1e-15);
+
+    // Extreme scales neither overflow nor underflow.
+    assert(fabs(C[4] - C[5]) <= 1e-15);
+    assert(fabs(C[4] - acos(-0.125)) <= 1e-15);
+
+    // Subnormal sides, with fewer significant bits.
+    assert(fabs(C[8] - acos(-0.125)) <= 1e-12);
+
+    // Obtuse A = 120° (7, 3, 5).
+    assert(fabs(A[6] - 2 * M_PI / 3) <= 1e-15);
+
+    // In parallel, the same for any number of threads.
+    std::vector<double> pa, pb, pc;
+    for (std::size_t i = 0; i < 1001; ++i) {
+        pa.push_back(a[i % size] * (1 + i));
+        pb.push_back(b[i % size] * (1 + i));
+        pc.push_back(c[i % size] * (1 + i));
+    }
+    auto n = pa.size();
+    std::vector<double> sA(n), sB(n), sC(n), pA(n), pB(n), pC(n);
+    std::unique_ptr<bool[]> sv(new bool[n]), pv(new bool[n]);
+    auto count = TriangleBatch::solve(pa.data(), pb.data(), pc.data(), n, sA.data(), sB.data(), sC.data(), sv.get());
+    for (std::size_t threads : {1, 3}) {
+        ThreadPool pool(threads);
+        assert(TriangleBatch::solve(pool, pa.data(), pb.data(), pc.data(), n, pA.data(), pB.data(), pC.data(), pv.get(), 7) == count);
+        assert(pA == sA && pB == sB && pC == sC);
+        assert(std::equal(pv.get(), pv.get() + n, sv.get()));
+    }
+}
+
+#endif
@@ -0,0 +1,28 @@
+#pragma once
+
+#include "threadpool.hpp"
+
+#include <cstddef>
+
+/// Solves triangles from columns of side lengths (structure of arrays).
+/// @discussion Angles follow from Heron's formula: with 4K = √((a+b+c)(-a+b+c)(a-b+c)(a+b-c)),
+/// A = atan2(4K, b² + c² - a²), and likewise for @c B and @c C. Unlike the cosine and sine rules,
+/// this is well-conditioned for every angle, including obtuse ones, so @c A + @c B + @c C = π.
+/// Agrees with @c Triangle (for acute @c A) within 1e-14 rad.
+class TriangleBatch
+{
+public:
+    /// Solve @c size triangles having sides @c a, @c b and @c c, storing angles (in radians) to @c A, @c B and @c C.
+    /// @discussion Triangles having a non-finite side, or breaking the strict triangle inequality (which includes
+    /// non-positive sides), are flagged false in @c valid, and their angles stored as zero.
+    /// Nothing is allocated; output columns may alias each other, but not the input.
+    /// @return std::size_t Number of valid triangles.
+    static std::size_t solve(const double * a, const double * b, const double * c, std::size_t size,
+                             double * A, double * B, double * C, bool * valid);
+
+    /// Solve as @c solve, in parallel on @c pool in chunks of @c grain triangles.
+    /// @discussion Output is the same as @c solve, for any number of threads.
+    /// @return std::size_t Number of valid triangles.
+    static std::size_t solve(ThreadPool & pool, const double * a, const double * b, const double * c, std::size_t size,
+                             double * A, double * B, double * C, bool * valid, std::size_t grain = ThreadPool::GRAIN);
+};
@@ -0,0 +1,201 @@
+#include "trianglereader.hpp"
+
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+
+namespace
+{
+
+/// @return const char * First character of [@c first, @c last) that is not a space, tab or carriage return.
+inline const char * skip(const char * first, const char * last)
+{
+    while (first != last && (*first == ' ' || *first == '\t' || *first == '\r')) {
+        ++first;
+    }
+    return first;
+}
+
+} // namespace
+
+TriangleReader::TriangleReader(std::FILE * file, std::size_t chunk)
+    : file_{file}, buffer_(chunk), begin_{0}, end_{0}, errors_{0}, skip_{false}
+{
+}
+
+std::size_t TriangleReader::errors() const
+{
+    return errors_;
+}
+
+bool TriangleReader::next(Record & record)
+{
+    for (;;) {
+        auto data = buffer_.data();
+        auto eol = static_cast<const char *>(std::memchr(data + begin_, '\n', end_ - begin_));
+        if (!eol && fill()) {
+            continue;
+        }
+        if (!eol) {
+            // The last line may lack a newline.
+            if (begin_ == end_) {
+                return false;
+            }
+            eol = data + end_;
+        }
+
+        auto first = skip(data + begin_, eol);
+        begin_ = std::min(static_cast<std::size_t>(eol - data) + 1, end_);
+
+        if (skip_) {
+            // Rest of an overlong line, already counted.
+            skip_ = false;
+        } else if (first != eol && *first != '#') {
+            if (parse(first, eol, record)) {
+                return true;
+            }
+            ++errors_;
+        }
+    }
+}
+
+bool TriangleReader::parse(const char * first, const char * last, Record & record)
+{
+    if (last - first < 3) {
+        return false;
+    }
+
+    if (std::memcmp(first, "sss", 3) == 0) {
+        record.kind = SSS;
+    } else if (std::memcmp(first, "sas", 3) == 0) {
+        record.kind = SAS;
+    } else if (std::memcmp(first, "asa", 3) == 0) {
+        record.kind = ASA;
+    } else {
+        return false;
+    }
+    first += 3;
+
+    for (auto & value : record.values) {
+        auto next = skip(first, last);
+        if (next == first) {
+            return false;
+        }
+        auto result = std::from_chars(next, last, value);
+        if (result.ec != std::errc()) {
+            return false;
+        }
+        first = result.ptr;
+    }
+    return skip(first, last) == last;
+}
+
+bool TriangleReader::fill()
+{
+    auto remainder = end_ - begin_;
+    if (remainder == buffer_.size()) {
+        // No record is this long; drop it, and the rest of its line.
+        errors_ += !skip_;
+        skip_ = true;
+        remainder = 0;
+    }
+
+    std::memmove(buffer_.data(), buffer_.data() + begin_, remainder);
+    begin_ = 0;
+    end_ = remainder;
+
+    auto size = std::fread(buffer_.data() + end_, 1, buffer_.size() - end_, file_);
+    end_ += size;
+    return size > 0;
+}
+
+#ifdef UNITTEST_TRIANGLEREADER
+
+#include "fcmp.hpp"
+
+#include <cassert>
+#include <string>
+
+namespace
+{
+
+/// @return std::FILE * Temporary file holding @c text.
+std::FILE * file(const std::string & text)
+{
+    auto f = std::tmpfile();
+    std::fputs(text.c_str(), f);
+    std::rewind(f);
+    return f;
+}
+
+} // namespace
+
+int main()
+{
+    const std::string text =
+        "# sides\n"
+        "sss 3 4 5\n"
+        "\n"
+        "sas\t5 5 73.7397952917\r\n"
+        "  asa 36.8698976458 53.1301023542 5  \n"
+        "sss 1e0 2.5E-1 0x1\n"
+        "sss 1 2\n"
+        "sss 1 x 3\n"
+        "sss 1 2 3 4\n"
+        "sss 1 2 3x\n"
+        "sss1 2 3\n"
+        "ssa 1 2 3\n"
+        "ss\n"
+        "sss 6 8 10";
+
+    // Chunks from larger than the file down to barely a record, so records straddle chunks.
+    for (std::size_t chunk : {std::size_t(4096), std::size_t(64), std::size_t(40)}) {
+        auto f = file(text);
+        TriangleReader reader(f, chunk);
+        std::vector<Triangle> t;
+
+        assert(reader.read(t, 2) == 2);
+        assert(t[0].description() == Triangle(3, 4, 5).description());
+        assert(fcmp(t[1].c(), 6) && fcmp(t[1].C(), Angle::degrees(73.7397952917)));
+
+        assert(reader.read(t, 100) == 2);
+        assert(fcmp(t[0].a(), 3) && fcmp(t[0].b(), 4) && fcmp(t[0].C(), Angle::degrees(90)));
+        assert(t[1].description() == Triangle(6, 8, 10).description());
+        assert(reader.errors() == 8);
+
+        assert(reader.read(t, 100) == 0 && t.empty());
+        std::fclose(f);
+    }
+
+    {
+        // Trigonometry policy.
+        auto f = file("sas 3 4 90\n");
+        TriangleReader reader(f);
+        std::vector<Triangle> t;
+        assert(reader.read<trig::Table<4096>>(t, 1) == 1);
+        assert(fcmp(t[0].c(), 5));
+        std::fclose(f);
+    }
+
+    {
+        // Lines longer than the chunk are skipped, however many chunks they span.
+        auto f = file("sss 3 4 5\nsss 3 4 5 " + std::string(100, ' ') + "\nsss 6 8 10\nsss 1 1 1 " + std::string(40, ' '));
+        TriangleReader reader(f, 16);
+        std::vector<Triangle> t;
+        assert(reader.read(t, 100) == 2);
+        assert(fcmp(t[1].a(), 6));
+        assert(reader.errors() == 2);
+        std::fclose(f);
+    }
+
+    {
+        auto f = file("");
+        TriangleReader reader(f);
+        std::vector<Triangle> t;
+        assert(reader.read(t, 1) == 0);
+        assert(reader.errors() == 0);
+        std::fclose(f);
+    }
+}
+
+#endif
@@ -0,0 +1,94 @@
+#pragma once
+
+#include "angle.hpp"
+#include "triangle.hpp"
+#include "trig.hpp"
+
+#include <cstddef>
+#include <cstdio>
+#include <vector>
+
+/// Reads triangles from newline-delimited text records, in one pass.
+/// @discussion Each record is a kind and three numbers, separated by spaces or tabs (angles in degrees):
+/// ```
+/// sss a b c
+/// sas a b C
+/// asa A B c
+/// ```
+/// Blank lines and lines starting with '#' are skipped; malformed records (including any longer than the
+/// chunk) are skipped and counted by @c errors.
+/// The file is read in fixed-size chunks and numbers are parsed in place with @c std::from_chars, so reading
+/// allocates nothing per record.
+class TriangleReader
+{
+public:
+    /// Default size of chunks, in bytes.
+    static constexpr std::size_t CHUNK_SIZE = 1 << 16;
+
+    /// Construct reader of @c file (which the caller closes), in chunks of @c chunk bytes.
+    explicit TriangleReader(std::FILE * file, std::size_t chunk = CHUNK_SIZE);
+
+    /// Read up to @c size records into @c triangles, replacing its contents.
+    /// @discussion Triangles are built by @c Triangle::with_a_b_c, @c Triangle::with_a_b_C and
+    /// @c Triangle::with_A_B_c with trigonometry policy @c Trig. Reuse @c triangles between batches to reuse
+    /// its storage.
+    /// @return std::size_t Number of triangles read: less than @c size only at the end of the file.
+    template <typename Trig = trig::Libm>
+    std::size_t read(std::vector<Triangle> & triangles, std::size_t size);
+
+    /// @return std::size_t Number of malformed records skipped.
+    std::size_t errors() const;
+
+private:
+    /// Kinds of record.
+    enum Kind : unsigned char
+    {
+        SSS,
+        SAS,
+        ASA,
+    };
+
+    struct Record
+    {
+        Kind kind;
+        double values[3];
+    };
+
+    /// Parse the next well-formed record into @c record.
+    /// @return bool Whether a record was parsed, or the end of the file was reached.
+    bool next(Record & record);
+
+    /// Parse the record in [@c first, @c last) into @c record.
+    /// @return bool Whether the record is well-formed.
+    static bool parse(const char * first, const char * last, Record & record);
+
+    /// Move the unparsed part of the chunk to the front, and read after it.
+    /// @return bool Whether any more was read.
+    bool fill();
+
+    std::FILE * file_;
+    std::vector<char> buffer_;
+    std::size_t begin_;
+    std::size_t end_;
+    std::size_t errors_;
+    bool skip_;
+};
+
+template <typename Trig>
+std::size_t TriangleReader::read(std::vector<Triangle> & triangles, std::size_t size)
+{
+    triangles.clear();
+
+    Record r;
+    while (triangles.size() < size && next(r)) {
+        if (r.kind == SSS) {
+            triangles.push_back(Triangle::with_a_b_c<Trig>(r.values[0], r.values[1], r.values[2]));
+        } else if (r.kind == SAS) {
+            triangles.push_back(Triangle::with_a_b_C<Trig>(r.values[0], r.values[1], Angle::degrees(r.values[2])));
+        } else {
+            triangles.push_back(
+                Triangle::with_A_B_c<Trig>(Angle::degrees(r.values[0]), Angle::degrees(r.values[1]), r.values[2]));
+        }
+    }
+    return triangles.size();
+}
@@ -0,0 +1,415 @@
+#include "trig.hpp"
+
+#include "simd.hpp"
+
+#include <array>
+#include <cmath>
+
+namespace
+{
+
+constexpr double PIO2_1 = 0x1.921fb544p+0;
+constexpr double PIO2_2 = 0x1.0b4611a6p-34;
+constexpr double PIO2_3 = 0x1.3198a2e037073p-69;
+constexpr double INV_PIO2 = 0x1.45f306dc9c883p-1;
+
+/// tan(π/8), the boundary of the reduced atan interval.
+constexpr double TAN_PI_8 = 0x1.a827999fcef34p-2;
+
+/// Reduce @c x by π/2 in three parts.
+/// @return double Remainder on ±π/4, with quadrant 0..3 in @c q.
+inline double quadrant(double x, long & q)
+{
+    auto n = simd::nearest(x * INV_PIO2);
+    q = static_cast<long>(n) & 3;
+    return ((x - n * PIO2_1) - n * PIO2_2) - n * PIO2_3;
+}
+
+/// @return double Polynomial @c c evaluated at @c z.
+template <std::size_t N>
+inline double horner(const std::array<double, N> & c, double z)
+{
+    auto p = c[N - 1];
+    for (auto i = N - 1; i-- > 0;) {
+        p = p * z + c[i];
+    }
+    return p;
+}
+
+/// Minimax coefficients, in powers of the squared reduced argument.
+/// @discussion Fitted by Remez exchange: sin(r)/r and cos(r) on ±π/4, atan(t)/t on ±tan(π/8).
+template <int Terms>
+struct Coefficients;
+
+template <>
+struct Coefficients<3>
+{
+    static constexpr std::array<double, 3> sin{0x1.fffedffc76a76p-1, -0x1.552710d721676p-3, 0x1.092441f5dcabfp-7};
+    static constexpr std::array<double, 3> cos{0x1.fffeb1a0eac1cp-1, -0x1.ffb37da179248p-2, 0x1.4af1ded8fc580p-5};
+    static constexpr std::array<double, 3> atan{0x1.fff2353c798a0p-1, -0x1.5145efb75ad21p-2, 0x1.4545a20621088p-3};
+};
+
+template <>
+struct Coefficients<4>
+{
+    static constexpr std::array<double, 4> sin{
+        0x1.ffffff2cc7c1fp-1, -0x1.55551a734bb93p-3, 0x1.10fe9a13ecb20p-7, -0x1.9745784a6a908p-13};
+    static constexpr std::array<double, 4> cos{
+        0x1.ffffff131e3f1p-1, -0x1.ffff9fd488c6cp-2, 0x1.553cec45d1704p-5, -0x1.64257d183dc28p-10};
+    static constexpr std::array<double, 4> atan{
+        0x1.ffff6ee3d750dp-1, -0x1.550bbbc676d48p-2, 0x1.8ee7b03f12a6cp-3, -0x1.ab85dd26ecc0dp-4};
+};
+
+template <>
+struct Coefficients<5>
+{
+    static constexpr std::array<double, 5> sin{
+        0x1.ffffffffa109ap-1, -0x1.5555552c6e8b8p-3, 0x1.1110fcc5d73cep-7, -0x1.a00938ad7153ap-13, 0x1.6bb1312458c18p-19};
+    static constexpr std::array<double, 5> cos{
+        0x1.ffffffff97c47p-1, -0x1.ffffffbdee95ep-2, 0x1.55553a875ae03p-5, -0x1.6c078624c82cep-10, 0x1.9906ffcfdf3b0p-16};
+    static constexpr std::array<double, 5> atan{
+        0x1.fffffa1f142adp-1, -0x1.5550be8ae6e46p-2, 0x1.988e4cec99cf7p-3, -0x1.17a5c43b2579bp-3, 0x1.323835b069d0cp-4};
+};
+
+/// Minimax kernels on the reduced intervals.
+template <int Terms>
+struct MinimaxKernel
+{
+    using C = Coefficients<Terms>;
+
+    /// @return double sin(r), for |r| ≤ π/4.
+    static double sin(double r)
+    {
+        return r * horner(C::sin, r * r);
+    }
+
+    /// @return double cos(r), for |r| ≤ π/4.
+    static double cos(double r)
+    {
+        return horner(C::cos, r * r);
+    }
+
+    /// @return double atan(t), for 0 ≤ t ≤ 1.
+    static double atan(double t)
+    {
+        // atan(t) = π/4 + atan((t - 1) / (t + 1))
+        auto offset = 0.;
+        if (t > TAN_PI_8) {
+            t = (t - 1.) / (t + 1.);
+            offset = M_PI_4;
+        }
+        return offset + t * horner(C::atan, t * t);
+    }
+};
+
+/// Lookup tables for @c Table<Size>, built from libm.
+template <int Size>
+struct Tables
+{
+    /// Step between sine entries.
+    static constexpr double STEP = 2. * M_PI / Size;
+
+    /// Entries either side of zero, covering ±π/4.
+    static constexpr int EIGHTH = Size / 8;
+
+    Tables()
+    {
+        for (auto j = -EIGHTH; j <= EIGHTH; ++j) {
+            sin[j + EIGHTH] = std::sin(j * STEP);
+            cos[j + EIGHTH] = std::cos(j * STEP);
+        }
+        for (auto j = 0; j <= Size; ++j) {
+            atan[j] = std::atan(static_cast<double>(j) / Size);
+        }
+    }
+
+    std::array<double, Size / 4 + 1> sin;
+    std::array<double, Size / 4 + 1> cos;
+    std::array<double, Size + 1> atan;
+};
+
+/// @return Tables Shared tables, built on first use.
+template <int Size>
+const Tables<Size> & tables()
+{
+    static const Tables<Size> t;
+    return t;
+}
+
+/// Table kernels on the reduced intervals.
+/// @discussion The nearest entry is rotated by the remainder @c d, using series for sin(d) and cos(d).
+template <int Size>
+struct TableKernel
+{
+    using T = Tables<Size>;
+
+    /// @return double sin(r), for |r| ≤ π/4.
+    static double sin(double r)
+    {
+        double sd, cd;
+        auto i = entry(r, sd, cd);
+        auto & t = tables<Size>();
+        // sin(a + d) = sin(a)cos(d) + cos(a)sin(d)
+        return t.sin[i] * cd + t.cos[i] * sd;
+    }
+
+    /// @return double cos(r), for |r| ≤ π/4.
+    static double cos(double r)
+    {
+        double sd, cd;
+        auto i = entry(r, sd, cd);
+        auto & t = tables<Size>();
+        // cos(a + d) = cos(a)cos(d) - sin(a)sin(d)
+        return t.cos[i] * cd - t.sin[i] * sd;
+    }
+
+    /// @return double atan(t), for 0 ≤ t ≤ 1.
+    static double atan(double t)
+    {
+        auto j = simd::nearest(t * Size);
+        auto x = j / Size;
+        // atan(t) = atan(x) + atan((t - x) / (1 + tx))
+        auto u = (t - x) / (1. + t * x);
+        return tables<Size>().atan[static_cast<int>(j)] + u * (1. - u * u / 3.);
+    }
+
+private:
+    /// @return int Index of the entry nearest @c r, with sin and cos of the remainder in @c sd and @c cd.
+    static int entry(double r, double & sd, double & cd)
+    {
+        auto j = simd::nearest(r * (1. / T::STEP));
+        auto d = r - j * T::STEP;
+        auto z = d * d;
+        sd = d * (1. - z / 6.);
+        cd = 1. - z / 2. * (1. - z / 12.);
+        return static_cast<int>(j) + T::EIGHTH;
+    }
+};
+
+template <typename Kernel>
+double sine(double x)
+{
+    if (!(fabs(x) < simd::SINCOS_LIMIT)) {
+        return std::sin(x);
+    }
+
+    long q;
+    auto r = quadrant(x, q);
+    auto v = q & 1 ? Kernel::cos(r) : Kernel::sin(r);
+    return q & 2 ? -v : v;
+}
+
+template <typename Kernel>
+double cosine(double x)
+{
+    if (!(fabs(x) < simd::SINCOS_LIMIT)) {
+        return std::cos(x);
+    }
+
+    long q;
+    auto r = quadrant(x, q);
+    auto v = q & 1 ? Kernel::sin(r) : Kernel::cos(r);
+    return (q + 1) & 2 ? -v : v;
+}
+
+template <typename Kernel>
+double tangent(double x)
+{
+    if (!(fabs(x) < simd::SINCOS_LIMIT)) {
+        return std::tan(x);
+    }
+
+    long q;
+    auto r = quadrant(x, q);
+    auto s = Kernel::sin(r);
+    auto c = Kernel::cos(r);
+    return q & 1 ? -c / s : s / c;
+}
+
+template <typename Kernel>
+double arctangent(double x)
+{
+    if (std::isnan(x)) {
+        return x;
+    }
+
+    // atan(t) = π/2 - atan(1/t)
+    auto t = fabs(x);
+    auto r = t > 1. ? M_PI_2 - Kernel::atan(1. / t) : Kernel::atan(t);
+    return x < 0 ? -r : r;
+}
+
+template <typename Kernel>
+double arcsine(double x)
+{
+    // asin(x) = atan(x / √(1 - x²))
+    return arctangent<Kernel>(x / sqrt((1. - x) * (1. + x)));
+}
+
+template <typename Kernel>
+double arccosine(double x)
+{
+    return M_PI_2 - arcsine<Kernel>(x);
+}
+
+} // namespace
+
+namespace trig
+{
+
+template <int Terms>
+double Minimax<Terms>::sin(double x)
+{
+    TRIG_COUNT(TRIG);
+    return sine<MinimaxKernel<Terms>>(x);
+}
+
+template <int Terms>
+double Minimax<Terms>::cos(double x)
+{
+    TRIG_COUNT(TRIG);
+    return cosine<MinimaxKernel<Terms>>(x);
+}
+
+template <int Terms>
+double Minimax<Terms>::tan(double x)
+{
+    TRIG_COUNT(TRIG);
+    return tangent<MinimaxKernel<Terms>>(x);
+}
+
+template <int Terms>
+double Minimax<Terms>::asin(double x)
+{
+    TRIG_COUNT(TRIG);
+    return arcsine<MinimaxKernel<Terms>>(x);
+}
+
+template <int Terms>
+double Minimax<Terms>::acos(double x)
+{
+    TRIG_COUNT(TRIG);
+    return arccosine<MinimaxKernel<Terms>>(x);
+}
+
+template <int Terms>
+double Minimax<Terms>::atan(double x)
+{
+    TRIG_COUNT(TRIG);
+    return arctangent<MinimaxKernel<Terms>>(x);
+}
+
+template <int Size>
+double Table<Size>::sin(double x)
+{
+    TRIG_COUNT(TRIG);
+    return sine<TableKernel<Size>>(x);
+}
+
+template <int Size>
+double Table<Size>::cos(double x)
+{
+    TRIG_COUNT(TRIG);
+    return cosine<TableKernel<Size>>(x);
+}
+
+template <int Size>
+double Table<Size>::tan(double x)
+{
+    TRIG_COUNT(TRIG);
+    return tangent<TableKernel<Size>>(x);
+}
+
+template <int Size>
+double Table<Size>::asin(double x)
+{
+    TRIG_COUNT(TRIG);
+    return arcsine<TableKernel<Size>>(x);
+}
+
+template <int Size>
+double Table<Size>::acos(double x)
+{
+    TRIG_COUNT(TRIG);
+    return arccosine<TableKernel<Size>>(x);
+}
+
+template <int Size>
+double Table<Size>::atan(double x)
+{
+    TRIG_COUNT(TRIG);
+    return arctangent<TableKernel<Size>>(x);
+}
+
+template struct Minimax<3>;
+template struct Minimax<4>;
+template struct Minimax<5>;
+template struct Table<256>;
+template struct Table<4096>;
+
+} // namespace trig
+
+#ifdef UNITTEST_TRIG
+
+#include <cassert>
+#include <limits>
+
+namespace
+{
+
+/// Check policy @c Trig against libm: @c bound for sin, cos and tan, and @c inverse for asin, acos and atan.
+template <typename Trig>
+void check(double bound, double inverse)
+{
+    for (auto i = 0; i <= 20001; ++i) {
+        auto x = -100. + i * (200. / 20001);
+        assert(fabs(Trig::sin(x) - std::sin(x)) <= bound);
+        assert(fabs(Trig::cos(x) - std::cos(x)) <= bound);
+        auto t = std::tan(x);
+        assert(fabs(Trig::tan(x) - t) <= bound * (1. + t * t));
+    }
+
+    for (auto i = 0; i <= 20001; ++i) {
+        auto x = -1. + i * (2. / 20001);
+        assert(fabs(Trig::asin(x) - std::asin(x)) <= inverse);
+        assert(fabs(Trig::acos(x) - std::acos(x)) <= inverse);
+    }
+
+    for (auto i = 0; i <= 20001; ++i) {
+        auto x = -50. + i * (100. / 20001);
+        assert(fabs(Trig::atan(x) - std::atan(x)) <= inverse);
+        assert(fabs(Trig::atan(1. / x) - std::atan(1. / x)) <= inverse);
+    }
+
+    // Exact points.
+    assert(fabs(Trig::asin(1.) - M_PI_2) <= inverse);
+    assert(fabs(Trig::acos(-1.) - M_PI) <= inverse);
+    assert(Trig::acos(1.) == 0.);
+    assert(fabs(Trig::atan(std::numeric_limits<double>::infinity()) - M_PI_2) <= inverse);
+
+    // Large and non-finite arguments take libm.
+    assert(Trig::sin(1e300) == std::sin(1e300));
+    assert(Trig::cos(1e300) == std::cos(1e300));
+    assert(Trig::tan(1e300) == std::tan(1e300));
+    auto nan = std::numeric_limits<double>::quiet_NaN();
+    assert(std::isnan(Trig::sin(nan)));
+    assert(std::isnan(Trig::cos(nan)));
+    assert(std::isnan(Trig::tan(nan)));
+    assert(std::isnan(Trig::atan(nan)));
+    assert(std::isnan(Trig::asin(2.)));
+    assert(std::isnan(Trig::acos(-2.)));
+}
+
+} // namespace
+
+int main()
+{
+    check<trig::Libm>(0., 0.);
+    check<trig::Minimax<3>>(1e-5, 1e-5);
+    check<trig::Minimax<4>>(3e-8, 3e-7);
+    check<trig::Minimax<5>>(1e-10, 1e-8);
+    check<trig::Table<256>>(1e-11, 1e-14);
+    check<trig::Table<4096>>(1e-15, 1e-15);
+}
+
+#endif
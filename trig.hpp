@@ -0,0 +1,90 @@
+#pragma once
+
+#include "instrument.hpp"
+
+#include <cmath>
+
+/// Trigonometry policies for the solvers.
+/// @discussion A policy is a type with static @c sin, @c cos, @c tan, @c asin, @c acos and @c atan over radians.
+/// Solvers take the policy as a template parameter (defaulting to @c Libm), so hot paths can trade accuracy
+/// for speed at compile time:
+/// ```
+/// auto t = RightAngledTriangle::with_A_c<trig::Minimax<4>>(A, c);
+/// ```
+/// Error bounds are absolute, against libm; @c tan is bounded relative to its derivative (1 + tan²).
+namespace trig
+{
+
+/// Exact trigonometry, from libm.
+/// @discussion Overloaded for @c float, @c double and @c long double, so solvers keep their precision.
+/// The other policies evaluate in @c double.
+struct Libm
+{
+    static double sin(double x) { TRIG_COUNT(TRIG); return std::sin(x); }
+    static double cos(double x) { TRIG_COUNT(TRIG); return std::cos(x); }
+    static double tan(double x) { TRIG_COUNT(TRIG); return std::tan(x); }
+    static double asin(double x) { TRIG_COUNT(TRIG); return std::asin(x); }
+    static double acos(double x) { TRIG_COUNT(TRIG); return std::acos(x); }
+    static double atan(double x) { TRIG_COUNT(TRIG); return std::atan(x); }
+
+    static float sin(float x) { TRIG_COUNT(TRIG); return std::sin(x); }
+    static float cos(float x) { TRIG_COUNT(TRIG); return std::cos(x); }
+    static float tan(float x) { TRIG_COUNT(TRIG); return std::tan(x); }
+    static float asin(float x) { TRIG_COUNT(TRIG); return std::asin(x); }
+    static float acos(float x) { TRIG_COUNT(TRIG); return std::acos(x); }
+    static float atan(float x) { TRIG_COUNT(TRIG); return std::atan(x); }
+
+    static long double sin(long double x) { TRIG_COUNT(TRIG); return std::sin(x); }
+    static long double cos(long double x) { TRIG_COUNT(TRIG); return std::cos(x); }
+    static long double tan(long double x) { TRIG_COUNT(TRIG); return std::tan(x); }
+    static long double asin(long double x) { TRIG_COUNT(TRIG); return std::asin(x); }
+    static long double acos(long double x) { TRIG_COUNT(TRIG); return std::acos(x); }
+    static long double atan(long double x) { TRIG_COUNT(TRIG); return std::atan(x); }
+};
+
+/// Minimax polynomial trigonometry, with @c Terms terms per polynomial.
+/// @discussion Arguments are reduced to ±π/4 (sin, cos, tan) or to ±tan(π/8) (asin, acos, atan) before
+/// evaluation. Tiers are instantiated for 3, 4 and 5 terms:
+///
+/// | Terms | sin, cos, tan | asin, acos, atan |
+/// |-------|---------------|------------------|
+/// | 3     | 1e-5          | 1e-5             |
+/// | 4     | 3e-8          | 3e-7             |
+/// | 5     | 1e-10         | 1e-8             |
+///
+/// Arguments beyond 2^20 quadrants, and non-finite arguments, fall back to libm.
+template <int Terms>
+struct Minimax
+{
+    static double sin(double x);
+    static double cos(double x);
+    static double tan(double x);
+    static double asin(double x);
+    static double acos(double x);
+    static double atan(double x);
+};
+
+/// Table-driven trigonometry, with @c Size entries per turn (and per unit of tangent).
+/// @discussion The nearest entry is corrected by a short series in the remainder, so the error falls with the
+/// fifth power of @c Size. Tables are built from libm on first use. Tiers are instantiated for 256 and 4096 entries:
+///
+/// | Size | sin, cos, tan | asin, acos, atan |
+/// |------|---------------|------------------|
+/// | 256  | 1e-11         | 1e-14            |
+/// | 4096 | 1e-15         | 1e-15            |
+///
+/// Arguments beyond 2^20 quadrants, and non-finite arguments, fall back to libm.
+template <int Size>
+struct Table
+{
+    static_assert(Size >= 8 && (Size & (Size - 1)) == 0, "Size must be a power of two, of at least 8");
+
+    static double sin(double x);
+    static double cos(double x);
+    static double tan(double x);
+    static double asin(double x);
+    static double acos(double x);
+    static double atan(double x);
+};
+
+} // namespace trig
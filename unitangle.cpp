@@ -0,0 +1,106 @@
+#include "unitangle.hpp"
+
+#include "instrument.hpp"
+
+#include <cmath>
+
+template <typename T>
+BasicUnitAngle<T>::BasicUnitAngle(const Angle & angle) :
+    angle_{angle}, cos_{std::cos(angle.rad())}, sin_{std::sin(angle.rad())}
+{
+    TRIG_COUNT(TRIG);
+    TRIG_COUNT(TRIG);
+}
+
+template <typename T>
+BasicUnitAngle<T> BasicUnitAngle<T>::radians(T rad)
+{
+    return BasicUnitAngle(Angle::radians(rad));
+}
+
+template <typename T>
+BasicUnitAngle<T> BasicUnitAngle<T>::degrees(T deg)
+{
+    return BasicUnitAngle(Angle::degrees(deg));
+}
+
+template class BasicUnitAngle<float>;
+template class BasicUnitAngle<double>;
+template class BasicUnitAngle<long double>;
+
+#ifdef UNITTEST_UNITANGLE
+
+#include "fcmp.hpp"
+
+#include <cassert>
+#include <initializer_list>
+#include <limits>
+
+namespace
+{
+
+/// Check unit angles in precision @c T.
+template <typename T>
+void test()
+{
+    using Angle = BasicAngle<T>;
+    using UnitAngle = BasicUnitAngle<T>;
+
+    constexpr int precision = std::numeric_limits<T>::digits10 - 3;
+
+    static_assert(UnitAngle().rad() == 0);
+    static_assert(UnitAngle().cos() == 1 && UnitAngle().sin() == 0 && UnitAngle().tan() == 0);
+
+    // The cached pair matches libm.
+    for (T deg : {T(0), T(30), T(90), T(135), T(200), T(-45), T(725)}) {
+        auto u = UnitAngle::degrees(deg);
+        auto a = Angle::degrees(deg);
+        assert(u.angle() == a);
+        assert(u.rad() == a.rad());
+        assert(u.deg() == a.deg());
+        assert(u.cos() == std::cos(a.rad()));
+        assert(u.sin() == std::sin(a.rad()));
+        assert(UnitAngle::radians(a.rad()).sin() == u.sin());
+        assert(UnitAngle(a).cos() == u.cos());
+    }
+    assert(fcmp(UnitAngle::degrees(45).tan(), 1, precision));
+
+    // Sums and differences track the angle.
+    auto a = UnitAngle::degrees(30);
+    auto b = UnitAngle::degrees(100);
+    for (auto u : {a + b, b + a, a - b, b - a, -a, -b}) {
+        assert(fcmp(u.cos(), std::cos(u.rad()), precision));
+        assert(fcmp(u.sin(), std::sin(u.rad()), precision));
+    }
+    assert(fcmp((a + b).angle(), Angle::degrees(130), precision));
+    assert(fcmp((a - b).angle(), Angle::degrees(290), precision));
+    assert(fcmp((-a).angle(), Angle::degrees(330), precision));
+
+    auto c = a;
+    c += b;
+    assert(fcmp(c.sin(), std::sin(Angle::degrees(130).rad()), precision));
+    c -= b;
+    c -= a;
+    assert(fcmp(c.cos(), 1, precision) && fcmp(c.sin(), 0, precision));
+
+    // Repeated sums stay on the unit circle.
+    auto d = UnitAngle();
+    auto step = UnitAngle::degrees(T(0.36));
+    for (auto i = 0; i < 100000; ++i) {
+        d += step;
+    }
+    assert(fcmp(d.cos() * d.cos() + d.sin() * d.sin(), 1, precision));
+    assert(fcmp(d.cos(), std::cos(d.rad()), precision - 2));
+    assert(fcmp(d.sin(), std::sin(d.rad()), precision - 2));
+}
+
+} // namespace
+
+int main()
+{
+    test<float>();
+    test<double>();
+    test<long double>();
+}
+
+#endif
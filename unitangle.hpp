@@ -0,0 +1,162 @@
+#pragma once
+
+#include "angle.hpp"
+
+/// Models an angle together with its cosine and sine (a unit complex number), in floating point type @c T.
+/// @discussion Sine and cosine are computed once, on construction from an angle; sums and differences combine
+/// them by complex multiplication, renormalised to unit length, so no further transcendental calls are made.
+/// Factories taking a unit angle (@c Vector, @c Transform, @c RightAngledTriangle::with_A_c) read the cached pair.
+/// Instantiated for @c float, @c double and @c long double.
+/// @see UnitAngle
+template <typename T>
+class BasicUnitAngle
+{
+public:
+    using Angle = BasicAngle<T>;
+
+    /// Construct an empty angle (zero radians).
+    constexpr BasicUnitAngle();
+
+    /// Construct unit angle of @c angle, computing its sine and cosine.
+    explicit BasicUnitAngle(const Angle & angle);
+
+    /// Construct unit angle in radians.
+    static BasicUnitAngle radians(T rad);
+
+    /// Construct unit angle in degrees.
+    static BasicUnitAngle degrees(T deg);
+
+    /// @return Angle The angle.
+    constexpr Angle angle() const;
+
+    /// @return T Radians.
+    constexpr T rad() const;
+
+    /// @return T Degrees.
+    constexpr T deg() const;
+
+    /// @return T Cached sine.
+    constexpr T sin() const;
+
+    /// @return T Cached cosine.
+    constexpr T cos() const;
+
+    /// @return T Tangent, from the cached sine and cosine.
+    constexpr T tan() const;
+
+    constexpr BasicUnitAngle & operator+=(const BasicUnitAngle & other);
+
+    constexpr BasicUnitAngle & operator-=(const BasicUnitAngle & other);
+
+    constexpr BasicUnitAngle operator+(const BasicUnitAngle & other) const;
+
+    constexpr BasicUnitAngle operator-(const BasicUnitAngle & other) const;
+
+    constexpr BasicUnitAngle operator-() const;
+
+private:
+    /// Private constructor.
+    constexpr BasicUnitAngle(const Angle & angle, T cos, T sin);
+
+    /// @return BasicUnitAngle Angle @c angle, with (@c cos, @c sin) scaled back towards unit length.
+    static constexpr BasicUnitAngle normalised(const Angle & angle, T cos, T sin);
+
+    Angle angle_;
+    T cos_;
+    T sin_;
+};
+
+/// Unit angle in double precision.
+using UnitAngle = BasicUnitAngle<double>;
+
+template <typename T>
+constexpr BasicUnitAngle<T>::BasicUnitAngle() : angle_{}, cos_{1}, sin_{0}
+{
+}
+
+template <typename T>
+constexpr BasicUnitAngle<T>::BasicUnitAngle(const Angle & angle, T cos, T sin) : angle_{angle}, cos_{cos}, sin_{sin}
+{
+}
+
+template <typename T>
+constexpr BasicUnitAngle<T> BasicUnitAngle<T>::normalised(const Angle & angle, T cos, T sin)
+{
+    // One Newton step towards unit length, so rounding does not compound over repeated sums.
+    auto k = (3 - (cos * cos + sin * sin)) / 2;
+    return BasicUnitAngle(angle, cos * k, sin * k);
+}
+
+template <typename T>
+constexpr BasicAngle<T> BasicUnitAngle<T>::angle() const
+{
+    return angle_;
+}
+
+template <typename T>
+constexpr T BasicUnitAngle<T>::rad() const
+{
+    return angle_.rad();
+}
+
+template <typename T>
+constexpr T BasicUnitAngle<T>::deg() const
+{
+    return angle_.deg();
+}
+
+template <typename T>
+constexpr T BasicUnitAngle<T>::sin() const
+{
+    return sin_;
+}
+
+template <typename T>
+constexpr T BasicUnitAngle<T>::cos() const
+{
+    return cos_;
+}
+
+template <typename T>
+constexpr T BasicUnitAngle<T>::tan() const
+{
+    return sin_ / cos_;
+}
+
+template <typename T>
+constexpr BasicUnitAngle<T> & BasicUnitAngle<T>::operator+=(const BasicUnitAngle & other)
+{
+    *this = *this + other;
+    return *this;
+}
+
+template <typename T>
+constexpr BasicUnitAngle<T> & BasicUnitAngle<T>::operator-=(const BasicUnitAngle & other)
+{
+    *this = *this - other;
+    return *this;
+}
+
+template <typename T>
+constexpr BasicUnitAngle<T> BasicUnitAngle<T>::operator+(const BasicUnitAngle & other) const
+{
+    // (c1 + is1)(c2 + is2)
+    return normalised(angle_ + other.angle_,
+                      cos_ * other.cos_ - sin_ * other.sin_,
+                      sin_ * other.cos_ + cos_ * other.sin_);
+}
+
+template <typename T>
+constexpr BasicUnitAngle<T> BasicUnitAngle<T>::operator-(const BasicUnitAngle & other) const
+{
+    // (c1 + is1)(c2 - is2)
+    return normalised(angle_ - other.angle_,
+                      cos_ * other.cos_ + sin_ * other.sin_,
+                      sin_ * other.cos_ - cos_ * other.sin_);
+}
+
+template <typename T>
+constexpr BasicUnitAngle<T> BasicUnitAngle<T>::operator-() const
+{
+    return BasicUnitAngle(Angle() - angle_, cos_, -sin_);
+}
@@ -1,98 +1,41 @@
 #include "vector.hpp"
 
-#include "rightangledtriangle.hpp"
-#include "triangle.hpp"
+#include "format.hpp"
+#include "instrument.hpp"
 
 #include <cmath>
-#include <iomanip>
-#include <sstream>
 
-Vector::Vector(const Point & head) : tail_{}, head_{head}
+template <typename T>
+BasicVector<T>::BasicVector(const Angle & direction, T magnitude) : BasicVector(UnitAngle(direction), magnitude)
 {
 }
 
-Vector::Vector(const Point & tail, const Point & head) : tail_{tail}, head_{head}
+template <typename T>
+BasicVector<T> BasicVector<T>::rotate(const BasicVector & v, const Angle & direction)
 {
+    return rotate(v, UnitAngle(direction));
 }
 
-Vector::Vector(const Angle & direction, double magnitude)
-{
-    // Build a right-angled triangle having theta (< 90°) in order to find dx,dy.
-    auto t = RightAngledTriangle::with_A_c(direction % Angle::radians(M_PI_2), magnitude);
-
-    //  (-,+) | (+,+)
-    // -------+------
-    //  (-,-) | (+,-)
-
-    double dx{}, dy{};
-
-    int quadrant = static_cast<int>(direction.rad() / M_PI_2);
-    switch (quadrant) {
-        case 0:
-            dx =  t.b();
-            dy =  t.a();
-            break;
-        case 1:
-            dx = -t.a();
-            dy =  t.b();
-            break;
-        case 2:
-            dx = -t.b();
-            dy = -t.a();
-            break;
-        case 3:
-            dx =  t.a();
-            dy = -t.b();
-            break;
-    }
-
-    tail_ = Point{};
-    head_ = Point{dx, dy};
-}
-
-Vector Vector::rotate(const Vector & v, const Angle & direction)
-{
-    return Vector{v.direction() + direction, v.magnitude()};
-}
-
-Vector Vector::translate(const Vector & v, const Point & point)
-{
-    return Vector{point + v.tail(), point + v.head()};
-}
-
-Vector & Vector::rotate(const Angle & direction)
+template <typename T>
+BasicVector<T> & BasicVector<T>::rotate(const Angle & direction)
 {
     *this = rotate(*this, direction);
     return *this;
 }
 
-Vector & Vector::translate(const Point & point)
-{
-    *this = translate(*this, point);
-    return *this;
-}
-
-Point Vector::tail() const
-{
-    return tail_;
-}
-
-Point Vector::head() const
-{
-    return head_;
-}
-
 namespace
 {
 
 /// @return @c x squared.
-inline double sqr(double x)
+template <typename T>
+inline T sqr(T x)
 {
-    return pow(x, 2);
+    return x * x;
 }
 
 /// @return Integer quadrant in the range 0..3.
-int quadrant(double dx, double dy)
+template <typename T>
+int quadrant(T dx, T dy)
 {
     //   II | I
     // -----+-----
@@ -115,56 +58,79 @@ int quadrant(double dx, double dy)
 
 } // namespace
 
-Angle Vector::direction() const
+template <typename T>
+BasicAngle<T> BasicVector<T>::direction() const
 {
     auto dx = head().x() - tail().x();
     auto dy = head().y() - tail().y();
 
     auto q = quadrant(dx, dy);
-    double opp, adj;
+    T opp, adj;
 
     if (q == 0 || q == 2) {
-        opp = fabs(dy);
-        adj = fabs(dx);
+        opp = std::fabs(dy);
+        adj = std::fabs(dx);
     } else {
-        opp = fabs(dx);
-        adj = fabs(dy);
+        opp = std::fabs(dx);
+        adj = std::fabs(dy);
     }
 
     if (std::fpclassify(opp) == FP_ZERO && std::fpclassify(adj) == FP_ZERO) {
         return Angle::radians(0);
     }
 
-    return Angle::radians(atan(opp / adj) + M_PI_2 * q);
+    TRIG_COUNT(TRIG);
+    return Angle::radians(std::atan(opp / adj) + PI_2<T> * q);
 }
 
-double Vector::magnitude() const
+template <typename T>
+T BasicVector<T>::magnitude() const
 {
     auto dx = head().x() - tail().x();
     auto dy = head().y() - tail().y();
 
-    return sqrt(sqr(dx) + sqr(dy));
+    return std::sqrt(sqr(dx) + sqr(dy));
+}
+
+template <typename T>
+std::string BasicVector<T>::description() const
+{
+    return describe(*this);
 }
 
-std::string Vector::description() const
+template <typename T>
+std::size_t BasicVector<T>::format_to(char * buffer, std::size_t size) const
 {
-    std::stringstream ss;
-    ss << "Vector "
+    auto d = direction();
+    return (Format(buffer, size) << "Vector "
         "(" << tail().x() << ", " << tail().y() << "), "
         "(" << head().x() << ", " << head().y() << "); "
-        << direction() << " (" << direction().deg() << "°), "
-        << magnitude();
-    return ss.str();
+        << d << " (" << d.deg() << "°), "
+        << magnitude()).size();
 }
 
+template class BasicVector<float>;
+template class BasicVector<double>;
+template class BasicVector<long double>;
+
 #ifdef UNITTEST_VECTOR
 
 #include "fcmp.hpp"
 
 #include <cassert>
+#include <limits>
 
-int main()
+namespace
+{
+
+/// Check vectors in precision @c T.
+template <typename T>
+void test()
 {
+    using Angle = BasicAngle<T>;
+    using Point = BasicPoint<T>;
+    using Vector = BasicVector<T>;
+
     // Constructors, accessors.
     {
         assert(fcmp(Vector(Point(  0,   0)).direction(), Angle::degrees(0)));
@@ -183,16 +149,23 @@ int main()
 
         assert(fcmp(Vector(Point( 3,  4)).direction(), Angle::radians(atan(4./3.))));
 
-        auto u = Vector(Point{2, 3});
-        assert(u.tail() == Point());
-        assert(u.head() == Point(2, 3));
+        constexpr auto u = Vector(Point{2, 3});
+        static_assert(u.tail().x() == 0 && u.tail().y() == 0);
+        static_assert(u.head().x() == 2 && u.head().y() == 3);
 
-        auto v = Vector(Point{5, 5}, Point{7, 8});
-        assert(v.tail() == Point(5, 5));
-        assert(v.head() == Point(7, 8));
+        constexpr auto v = Vector(Point{5, 5}, Point{7, 8});
+        static_assert(v.tail().x() == 5 && v.tail().y() == 5);
+        static_assert(v.head().x() == 7 && v.head().y() == 8);
         assert(fcmp(v.direction(), u.direction()));
         assert(fcmp(v.magnitude(), u.magnitude()));
 
+        assert(Vector(Angle::degrees(  0), 2).head() == Point( 2,  0));
+        assert(Vector(Angle::degrees( 90), 2).head() == Point( 0,  2));
+        assert(Vector(Angle::degrees(180), 2).head() == Point(-2,  0));
+        assert(Vector(Angle::degrees(270), 2).head() == Point( 0, -2));
+        assert(Vector(Angle::degrees(135), sqrt(2)).head() == Point(-1, 1));
+        assert(Vector(Angle::degrees(300), 2).tail() == Point());
+
         auto w = Vector(u.direction(), u.magnitude());
         assert(w.tail() == u.tail());
         assert(w.head() == u.head());
@@ -213,10 +186,27 @@ int main()
         assert(w.tail() == u.tail());
         assert(w.head() == u.head());
 
+        w = Vector::rotate(Vector(Point{1, 1}, Point{3, 4}), Angle::degrees(90));
+        assert(w.tail() == Point());
+        assert(w.head() == Point(-3, 2));
+
+        // Repeated rotation does not drift, beyond the last six significant digits.
+        constexpr auto digits = std::numeric_limits<T>::digits10 - 6;
+        w = u;
+        for (int i = 0; i < 3600; ++i) {
+            w.rotate(Angle::degrees(0.1));
+        }
+        assert(fcmp(w.head().x(), u.head().x(), digits));
+        assert(fcmp(w.head().y(), u.head().y(), digits));
+
         w = Vector::translate(u, Point{});
         assert(w.tail() == u.tail());
         assert(w.head() == u.head());
 
+        constexpr auto t = Vector::translate(Vector(Point{2, 3}), Point{-1, -1});
+        static_assert(t.tail().x() == -1 && t.tail().y() == -1);
+        static_assert(t.head().x() ==  1 && t.head().y() ==  2);
+
         v = Vector(Point{-1, -1}, Point{1, 2});
         assert(fcmp(v.direction(), u.direction()));
         assert(fcmp(v.magnitude(), u.magnitude()));
@@ -264,7 +254,34 @@ int main()
         assert(fcmp(w.magnitude(), v.magnitude()));
     }
 
+    // Unit angles give the same vectors as angles, from their cached sine and cosine.
+    {
+        using UnitAngle = BasicUnitAngle<T>;
+
+        auto u = Vector(Point{3, 4});
+        for (auto deg : {0, 30, 90, 200, -45}) {
+            auto a = Angle::degrees(T(deg));
+            auto v = Vector(UnitAngle(a), 5);
+            auto w = Vector(a, 5);
+            assert(v.head() == w.head());
+            assert(Vector(u).rotate(UnitAngle(a)).head() == Vector(u).rotate(a).head());
+            assert(Vector::rotate(u, UnitAngle(a)).head() == Vector::rotate(u, a).head());
+        }
+
+        constexpr auto v = Vector::rotate(Vector(Point{3, 4}), UnitAngle());
+        static_assert(v.head().x() == 3 && v.head().y() == 4);
+    }
+
     assert(Vector(Point(3, 4)).description() == std::string("Vector (0, 0), (3, 4); 0.927295 (53.1301°), 5"));
 }
 
+} // namespace
+
+int main()
+{
+    test<float>();
+    test<double>();
+    test<long double>();
+}
+
 #endif
@@ -2,42 +2,62 @@
 
 #include "angle.hpp"
 #include "point.hpp"
+#include "unitangle.hpp"
 
+#include <cstddef>
 #include <string>
 
-/// Models a vector.
+/// Models a vector, in floating point type @c T.
 /// @see https://en.wikipedia.org/wiki/Euclidean_vector
 /// @discussion Positive directions are counter-clockwise (right-handed Cartesian coordinate system).
-class Vector
+/// Instantiated for @c float, @c double and @c long double.
+/// @see Vector
+template <typename T>
+class BasicVector
 {
 public:
+    using Angle = BasicAngle<T>;
+    using Point = BasicPoint<T>;
+    using UnitAngle = BasicUnitAngle<T>;
+
     /// Construct a vector in the standard position (with tail at origin).
-    Vector(const Point & head);
+    constexpr BasicVector(const Point & head);
 
     /// Construct a vector from @c tail to @c head.
     /// @see translate
-    Vector(const Point & tail, const Point & head);
+    constexpr BasicVector(const Point & tail, const Point & head);
 
     /// Construct a vector having @c direction and @c magnitude.
-    Vector(const Angle & direction, double magnitude);
+    BasicVector(const Angle & direction, T magnitude);
+
+    /// Construct a vector having @c direction and @c magnitude, from its cached sine and cosine.
+    constexpr BasicVector(const UnitAngle & direction, T magnitude);
 
     /// Construct vector by rotating @c v by @c direction.
-    static Vector rotate(const Vector & v, const Angle & direction);
+    /// @discussion The result is in the standard position (with tail at origin).
+    static BasicVector rotate(const BasicVector & v, const Angle & direction);
+
+    /// Construct vector by rotating @c v by @c direction, from its cached sine and cosine.
+    /// @discussion The result is in the standard position (with tail at origin).
+    static constexpr BasicVector rotate(const BasicVector & v, const UnitAngle & direction);
 
     /// Construct vector @c v translated to point @c point.
-    static Vector translate(const Vector & v, const Point & point);
+    static constexpr BasicVector translate(const BasicVector & v, const Point & point);
 
     /// Mutate vector by rotating by @c direction.
-    Vector & rotate(const Angle & direction);
+    BasicVector & rotate(const Angle & direction);
+
+    /// Mutate vector by rotating by @c direction, from its cached sine and cosine.
+    constexpr BasicVector & rotate(const UnitAngle & direction);
 
     /// Mutate vector by translating to @c point.
-    Vector & translate(const Point & point);
+    constexpr BasicVector & translate(const Point & point);
 
     /// @return Point The initial point.
-    Point tail() const;
+    constexpr Point tail() const;
 
     /// @return Point The terminal point.
-    Point head() const;
+    constexpr Point head() const;
 
     /// Return direction of the vector.
     /// @discussion By convention zero is on the positive @c x axis, and
@@ -52,13 +72,83 @@ public:
     /// @return Angle The direction.
     Angle direction() const;
 
-    /// @return double The magnitude.
-    double magnitude() const;
+    /// @return T The magnitude.
+    T magnitude() const;
 
     /// @return std::string Description.
     std::string description() const;
 
+    /// Format description into @c buffer of @c size characters, without allocating.
+    /// @discussion Writes at most @c size characters, without a terminator; the output matches @c description.
+    /// @see format_to(const T &, OutputIt) to format to an output iterator.
+    /// @return std::size_t Length of the whole description.
+    std::size_t format_to(char * buffer, std::size_t size) const;
+
 private:
     Point tail_;
     Point head_;
 };
+
+/// Vector in double precision.
+using Vector = BasicVector<double>;
+
+template <typename T>
+constexpr BasicVector<T>::BasicVector(const Point & head) : tail_{}, head_{head}
+{
+}
+
+template <typename T>
+constexpr BasicVector<T>::BasicVector(const Point & tail, const Point & head) : tail_{tail}, head_{head}
+{
+}
+
+template <typename T>
+constexpr BasicVector<T>::BasicVector(const UnitAngle & direction, T magnitude) :
+    tail_{}, head_{magnitude * direction.cos(), magnitude * direction.sin()}
+{
+}
+
+template <typename T>
+constexpr BasicVector<T> BasicVector<T>::rotate(const BasicVector & v, const UnitAngle & direction)
+{
+    // Apply the rotation matrix to the components.
+    // | cos -sin | |dx|
+    // | sin  cos | |dy|
+    auto c = direction.cos();
+    auto s = direction.sin();
+    auto dx = v.head_.x() - v.tail_.x();
+    auto dy = v.head_.y() - v.tail_.y();
+    return BasicVector{Point{dx * c - dy * s, dx * s + dy * c}};
+}
+
+template <typename T>
+constexpr BasicVector<T> & BasicVector<T>::rotate(const UnitAngle & direction)
+{
+    *this = rotate(*this, direction);
+    return *this;
+}
+
+template <typename T>
+constexpr BasicVector<T> BasicVector<T>::translate(const BasicVector & v, const Point & point)
+{
+    return BasicVector{point + v.tail(), point + v.head()};
+}
+
+template <typename T>
+constexpr BasicVector<T> & BasicVector<T>::translate(const Point & point)
+{
+    *this = translate(*this, point);
+    return *this;
+}
+
+template <typename T>
+constexpr BasicPoint<T> BasicVector<T>::tail() const
+{
+    return tail_;
+}
+
+template <typename T>
+constexpr BasicPoint<T> BasicVector<T>::head() const
+{
+    return head_;
+}